@@ -0,0 +1,154 @@
+#include "adaptive.h"
+#include "morph_1d.h"
+#include <algorithm>
+#include <omp.h>
+
+void SparseTable2D::build(const std::vector<unsigned char>& input, const int width, const int height,
+                          const int max_radius, const bool use_min) {
+
+    width_ = width;
+    height_ = height;
+    use_min_ = use_min;
+
+    const int max_side = std::max(1, std::min(2 * max_radius + 1, std::max(width, height)));
+    log2_.assign(max_side + 1, 0);
+    for (int n = 2; n <= max_side; ++n) log2_[n] = log2_[n / 2] + 1;
+
+    const int num_levels = log2_[max_side] + 1;
+    levels_.assign(num_levels, std::vector<unsigned char>());
+    levels_[0] = input;
+
+    for (int k = 1; k < num_levels; ++k) {
+        const int half = 1 << (k - 1);
+        const std::vector<unsigned char>& prev = levels_[k - 1];
+        std::vector<unsigned char>& cur = levels_[k];
+        cur.assign(static_cast<size_t>(width) * height, use_min ? 255 : 0);
+
+        // only corners whose full 2^k square fits are valid
+        const int rows = height - (1 << k) + 1;
+        const int cols = width - (1 << k) + 1;
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < rows; ++i) {
+            const unsigned char* a = &prev[static_cast<size_t>(i) * width];
+            const unsigned char* b = &prev[static_cast<size_t>(i + half) * width];
+            unsigned char* out = &cur[static_cast<size_t>(i) * width];
+            for (int j = 0; j < cols; ++j) {
+                if (use_min) {
+                    out[j] = std::min(std::min(a[j], a[j + half]), std::min(b[j], b[j + half]));
+                } else {
+                    out[j] = std::max(std::max(a[j], a[j + half]), std::max(b[j], b[j + half]));
+                }
+            }
+        }
+    }
+}
+
+unsigned char SparseTable2D::query(const int x0, const int y0, const int x1, const int y1) const {
+    const int side = std::min(x1 - x0, y1 - y0);
+    const int k = log2_[std::min(side, static_cast<int>(log2_.size()) - 1)];
+    const int s = 1 << k;
+    const std::vector<unsigned char>& level = levels_[k];
+
+    // cover the rectangle with s x s squares; the last one is aligned to the far edge
+    unsigned char val = use_min_ ? 255 : 0;
+    for (int y = y0;; y += s) {
+        const int sy = std::min(y, y1 - s);
+        const unsigned char* row = &level[static_cast<size_t>(sy) * width_];
+        for (int x = x0;; x += s) {
+            const int sx = std::min(x, x1 - s);
+            val = use_min_ ? std::min(val, row[sx]) : std::max(val, row[sx]);
+            if (sx == x1 - s) break;
+        }
+        if (sy == y1 - s) break;
+    }
+    return val;
+}
+
+static void adaptive_filter(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height,
+                            const std::vector<unsigned char>& radius_map, const bool erode) {
+
+    output.resize(static_cast<size_t>(width) * height);
+    if (output.empty()) return;
+
+    const int max_radius = *std::max_element(radius_map.begin(), radius_map.begin() + width * height);
+    SparseTable2D table;
+    table.build(input, width, height, max_radius, erode);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < height; ++i) {
+        for (int j = 0; j < width; ++j) {
+            const int r = radius_map[i * width + j];
+            output[i * width + j] = table.query(std::max(0, j - r), std::max(0, i - r),
+                                                std::min(width, j + r + 1), std::min(height, i + r + 1));
+        }
+    }
+}
+
+void Erode_Adaptive_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height,
+                             const std::vector<unsigned char>& radius_map) {
+
+    adaptive_filter(input, output, width, height, radius_map, true);
+}
+
+void Dilate_Adaptive_Parallel(const std::vector<unsigned char>& input,
+                              std::vector<unsigned char>& output,
+                              const int width, const int height,
+                              const std::vector<unsigned char>& radius_map) {
+
+    adaptive_filter(input, output, width, height, radius_map, false);
+}
+
+// The adjoint dilation scatters each eroded value over its own window. Pixels
+// are grouped by radius and each group is dilated with a fixed square (van
+// Herk, rows then columns), so the cost is O(N) per distinct radius.
+void Opening_Adaptive_Parallel(const std::vector<unsigned char>& input,
+                               std::vector<unsigned char>& output,
+                               const int width, const int height,
+                               const std::vector<unsigned char>& radius_map) {
+
+    const int num_pixels = width * height;
+    std::vector<unsigned char> eroded;
+    Erode_Adaptive_Parallel(input, eroded, width, height, radius_map);
+
+    output.assign(num_pixels, 0);
+    bool present[256] = {};
+    for (int i = 0; i < num_pixels; ++i) present[radius_map[i]] = true;
+
+    std::vector<unsigned char> group(num_pixels);
+    std::vector<unsigned char> rows_done(num_pixels);
+
+    for (int r = 0; r < 256; ++r) {
+        if (!present[r]) continue;
+
+        #pragma omp parallel
+        {
+            VanHerkScratch scratch;
+            std::vector<unsigned char> line(height);
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < num_pixels; ++i) {
+                group[i] = radius_map[i] == r ? eroded[i] : 0;
+            }
+
+            #pragma omp for schedule(static)
+            for (int i = 0; i < height; ++i) {
+                dilate_1d(&group[static_cast<size_t>(i) * width], 1,
+                          &rows_done[static_cast<size_t>(i) * width], 1, width, r, scratch);
+            }
+
+            #pragma omp for schedule(static)
+            for (int j = 0; j < width; ++j) {
+                dilate_1d(&rows_done[j], width, line.data(), 1, height, r, scratch);
+                for (int i = 0; i < height; ++i) {
+                    unsigned char& dst = output[static_cast<size_t>(i) * width + j];
+                    dst = std::max(dst, line[i]);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef ADAPTIVE_H
+#define ADAPTIVE_H
+
+#include <vector>
+
+// --- MORFOLOGÍA ADAPTATIVA (radio variable por píxel) ---
+//
+// radius_map holds one kernel radius per pixel (window 2r+1 x 2r+1, clipped
+// to the image like the fixed-size kernels).
+
+// Log-level min or max pyramid: level k stores the extremum of the
+// 2^k x 2^k square whose top-left corner is each pixel. Any rectangle is
+// answered with a constant number of lookups (four for a square window).
+class SparseTable2D {
+public:
+    void build(const std::vector<unsigned char>& input, const int width, const int height,
+               const int max_radius, const bool use_min);
+
+    // Extremum over rows [y0, y1) and columns [x0, x1); the range must be non-empty
+    unsigned char query(const int x0, const int y0, const int x1, const int y1) const;
+
+private:
+    int width_ = 0;
+    int height_ = 0;
+    bool use_min_ = true;
+    std::vector<std::vector<unsigned char>> levels_;
+    std::vector<int> log2_;  // floor(log2(n)) for n up to the largest window side
+};
+
+void Erode_Adaptive_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height,
+                             const std::vector<unsigned char>& radius_map);
+
+void Dilate_Adaptive_Parallel(const std::vector<unsigned char>& input,
+                              std::vector<unsigned char>& output,
+                              const int width, const int height,
+                              const std::vector<unsigned char>& radius_map);
+
+// Adaptive erosion followed by its adjoint dilation (each eroded value is
+// spread over the window of the pixel it came from), so the result is a
+// true opening: anti-extensive and idempotent
+void Opening_Adaptive_Parallel(const std::vector<unsigned char>& input,
+                               std::vector<unsigned char>& output,
+                               const int width, const int height,
+                               const std::vector<unsigned char>& radius_map);
+
+#endif // ADAPTIVE_H
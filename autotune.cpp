@@ -0,0 +1,251 @@
+#include "autotune.h"
+#include "parallel.h"
+#include "roi.h"
+#include "fused.h"
+#include "pool_parallel.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <tuple>
+#include <omp.h>
+
+namespace {
+
+// Measurements run on a full-width strip of 1 / TUNING_STRIP_FRACTION of
+// the rows (at least 2 kernels tall), so the work per thread grows with
+// the bucket like the real image does
+const int TUNING_STRIP_FRACTION = 8;
+// A configuration whose warm-up is this many times slower than the best so
+// far is not timed further
+const double TUNING_PRUNE_FACTOR = 2.0;
+// Timed runs per configuration (the minimum is kept), after one warm-up
+const int TUNING_REPETITIONS = 3;
+
+using OpeningFunction = void (*)(const std::vector<unsigned char>&, std::vector<unsigned char>&,
+                                 const int, const int, const int);
+
+// Separable van Herk opening of the whole image (the ROI code with a full rect)
+void opening_separable(const std::vector<unsigned char>& input,
+                       std::vector<unsigned char>& output,
+                       const int width, const int height, const int kernel_size) {
+
+    Opening_ROI_Parallel(input, output, width, height, kernel_size, Rect{0, 0, width, height});
+}
+
+enum class Runner {
+    OpenMP,   // `opening` with the OpenMP thread count set
+    Tiled,    // Opening_Parallel_Tiled with a tuned tile size
+    Pool,     // Opening_Pool on a tuner-owned pool
+};
+
+struct Candidate {
+    const char* name;
+    Runner runner;
+    OpeningFunction opening;
+};
+
+const Candidate CANDIDATES[] = {
+    {"openmp", Runner::OpenMP, Opening_Parallel},
+    {"tiled", Runner::Tiled, nullptr},
+    {"separable", Runner::OpenMP, opening_separable},
+    {"fused", Runner::OpenMP, Opening_Parallel_Fused},
+    {"threadpool", Runner::Pool, nullptr},
+};
+
+// Tile sides tried for "tiled"; 0 is the L2-derived Tile_Size_For_Kernel
+const int TILE_SIZES[] = {0, 64, 128, 256};
+
+// (size bucket, kernel size, thread budget)
+using BucketKey = std::tuple<int, int, int>;
+
+std::mutex cache_mutex;
+std::string cache_path = "tuning_cache.txt";
+bool cache_loaded = false;
+std::map<BucketKey, TuningChoice> cache;
+
+int size_bucket(const long long pixels) {
+    int bucket = 0;
+    while ((2LL << bucket) <= pixels) ++bucket;
+    return bucket;
+}
+
+const Candidate* find_candidate(const std::string& name) {
+    for (const Candidate& candidate : CANDIDATES) {
+        if (name == candidate.name) return &candidate;
+    }
+    return nullptr;
+}
+
+// Cache lines: size_bucket kernel_size budget algorithm threads tile_size time_ms
+// (lines with another number of fields, e.g. from before tile tuning, are ignored)
+const int CACHE_FIELDS = 7;
+
+void load_cache_locked() {
+    cache_loaded = true;
+    std::ifstream file(cache_path);
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream count_fields(line);
+        std::string token;
+        int num_fields = 0;
+        while (count_fields >> token) ++num_fields;
+        if (num_fields != CACHE_FIELDS) continue;
+
+        std::istringstream fields(line);
+        int bucket, kernel_size, budget;
+        TuningChoice choice;
+        if (!(fields >> bucket >> kernel_size >> budget >> choice.algorithm
+                     >> choice.threads >> choice.tile_size >> choice.time_ms)) continue;
+        if (!find_candidate(choice.algorithm) || choice.threads < 1) continue;
+        cache[BucketKey(bucket, kernel_size, budget)] = choice;
+    }
+}
+
+void append_cache_locked(const BucketKey& key, const TuningChoice& choice) {
+    std::ofstream file(cache_path, std::ios::app);
+    file << std::get<0>(key) << " " << std::get<1>(key) << " " << std::get<2>(key) << " "
+         << choice.algorithm << " " << choice.threads << " " << choice.tile_size << " "
+         << choice.time_ms << std::endl;
+}
+
+// Pools of the threadpool candidate, one per thread count and owned here so
+// the process-wide Default_Thread_Pool() is never resized. A pool runs one
+// job at a time, hence the mutex per pool.
+struct TunerPool {
+    std::mutex mutex;
+    std::unique_ptr<ThreadPool> pool;
+};
+
+std::mutex pools_mutex;
+std::map<int, std::unique_ptr<TunerPool>> tuner_pools;
+
+TunerPool& tuner_pool(const int threads) {
+    std::lock_guard<std::mutex> lock(pools_mutex);
+    std::unique_ptr<TunerPool>& entry = tuner_pools[threads];
+    if (!entry) {
+        entry.reset(new TunerPool());
+        entry->pool.reset(new ThreadPool(threads));
+    }
+    return *entry;
+}
+
+// Runs a candidate with `threads` threads (and `tile_size` for "tiled");
+// the caller's OpenMP thread count is restored afterwards
+void run_candidate(const Candidate& candidate, const int threads, const int tile_size,
+                   const std::vector<unsigned char>& input, std::vector<unsigned char>& output,
+                   const int width, const int height, const int kernel_size) {
+
+    if (candidate.runner == Runner::Pool) {
+        TunerPool& entry = tuner_pool(threads);
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        Opening_Pool(input, output, width, height, kernel_size, *entry.pool);
+        return;
+    }
+
+    const int budget = omp_get_max_threads();
+    omp_set_num_threads(threads);
+    if (candidate.runner == Runner::Tiled) {
+        Opening_Parallel_Tiled(input, output, width, height, kernel_size, tile_size);
+    } else {
+        candidate.opening(input, output, width, height, kernel_size);
+    }
+    omp_set_num_threads(budget);
+}
+
+TuningChoice measure(const int width, const int height, const int kernel_size, const int budget) {
+    const int w = std::max(1, width);
+    const int h = std::max(1, std::min(height, std::max(2 * kernel_size, height / TUNING_STRIP_FRACTION)));
+
+    std::vector<unsigned char> image(static_cast<size_t>(w) * h);
+    std::mt19937 rng(12345);
+    for (unsigned char& pixel : image) pixel = static_cast<unsigned char>(rng() & 0xff);
+
+    std::vector<int> thread_counts;
+    for (int t = 1; t < budget; t *= 2) thread_counts.push_back(t);
+    thread_counts.push_back(budget);
+
+    TuningChoice best;
+    best.time_ms = -1.0;
+    std::vector<unsigned char> result;
+
+    const std::vector<int> tile_sizes(std::begin(TILE_SIZES), std::end(TILE_SIZES));
+    const std::vector<int> no_tile_size = {0};
+
+    for (const Candidate& candidate : CANDIDATES) {
+        const std::vector<int>& tiles = candidate.runner == Runner::Tiled ? tile_sizes : no_tile_size;
+
+        for (int threads : thread_counts) {
+            for (int tile_size : tiles) {
+                double start = omp_get_wtime();
+                run_candidate(candidate, threads, tile_size, image, result, w, h, kernel_size);
+                double fastest = omp_get_wtime() - start;
+
+                const bool promising = best.time_ms < 0.0 || fastest * 1000.0 < TUNING_PRUNE_FACTOR * best.time_ms;
+                for (int rep = 0; promising && rep < TUNING_REPETITIONS; ++rep) {
+                    start = omp_get_wtime();
+                    run_candidate(candidate, threads, tile_size, image, result, w, h, kernel_size);
+                    fastest = std::min(fastest, omp_get_wtime() - start);
+                }
+
+                if (best.time_ms < 0.0 || fastest * 1000.0 < best.time_ms) {
+                    best.algorithm = candidate.name;
+                    best.threads = threads;
+                    best.tile_size = tile_size;
+                    best.time_ms = fastest * 1000.0;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace
+
+std::vector<std::string> Autotune_Candidates() {
+    std::vector<std::string> names;
+    for (const Candidate& candidate : CANDIDATES) names.push_back(candidate.name);
+    return names;
+}
+
+void Set_Tuning_Cache_File(const std::string& path) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache_path = path;
+    cache.clear();
+    load_cache_locked();
+}
+
+TuningChoice Autotune_Opening(const int width, const int height, const int kernel_size) {
+    const int budget = omp_get_max_threads();
+    const BucketKey key(size_bucket(static_cast<long long>(width) * height), kernel_size, budget);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (!cache_loaded) load_cache_locked();
+
+    auto found = cache.find(key);
+    if (found != cache.end()) return found->second;
+
+    TuningChoice choice = measure(width, height, kernel_size, budget);
+    cache[key] = choice;
+    append_cache_locked(key, choice);
+    return choice;
+}
+
+void Opening_Auto(const std::vector<unsigned char>& input,
+                  std::vector<unsigned char>& output,
+                  const int width, const int height, const int kernel_size) {
+
+    const TuningChoice choice = Autotune_Opening(width, height, kernel_size);
+    const Candidate* candidate = find_candidate(choice.algorithm);
+    if (!candidate) {
+        Opening_Parallel(input, output, width, height, kernel_size);
+        return;
+    }
+
+    run_candidate(*candidate, choice.threads, choice.tile_size, input, output, width, height, kernel_size);
+}
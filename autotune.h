@@ -0,0 +1,41 @@
+#ifndef AUTOTUNE_H
+#define AUTOTUNE_H
+
+#include <string>
+#include <vector>
+
+// --- AUTOAJUSTE (algoritmo, tamaño de tesela y número de hilos por carga de trabajo) ---
+//
+// Workloads are bucketed by (floor(log2(pixels)), kernel_size, thread
+// budget), where the budget is omp_get_max_threads() of the caller. The
+// first Opening_Auto call in a bucket micro-benchmarks every candidate
+// algorithm (and, for "tiled", tile sides 64/128/256 and the L2-derived
+// one) with every power-of-two thread count up to the budget on a
+// random full-width strip with 1/8 of the image rows (at least two kernels
+// tall), keeps the fastest, and appends it to the tuning cache file. Later
+// calls, and later runs that find the bucket in the file, dispatch without
+// measuring. The threadpool candidate runs on pools owned by the tuner, so
+// Default_Thread_Pool() and the caller's OpenMP thread count are unchanged.
+
+struct TuningChoice {
+    std::string algorithm;   // "openmp", "tiled", "separable", "fused", "threadpool"
+    int threads = 1;
+    int tile_size = 0;       // "tiled" only: tile side, 0 = Tile_Size_For_Kernel
+    double time_ms = 0.0;    // measured on the tuning strip
+};
+
+// Names of the candidate algorithms, in measurement order
+std::vector<std::string> Autotune_Candidates();
+
+// Uses `path` as the tuning cache (default "tuning_cache.txt") and loads it
+void Set_Tuning_Cache_File(const std::string& path);
+
+// Winner for this workload; measures and persists it if it is not cached yet
+TuningChoice Autotune_Opening(const int width, const int height, const int kernel_size);
+
+// Opening with the tuned algorithm and thread count (same result as Opening_Parallel)
+void Opening_Auto(const std::vector<unsigned char>& input,
+                  std::vector<unsigned char>& output,
+                  const int width, const int height, const int kernel_size);
+
+#endif // AUTOTUNE_H
@@ -0,0 +1,159 @@
+#include "batch.h"
+#include "sequential.h"
+#include "parallel.h"
+#include "roi.h"
+#include "morph_1d.h"
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <omp.h>
+
+BatchTiming Opening_Batch_Throughput(const std::vector<GrayImage>& images,
+                                     std::vector<std::vector<unsigned char>>& results,
+                                     const int kernel_size) {
+
+    const int num_images = static_cast<int>(images.size());
+    results.resize(num_images);
+    std::atomic<int> next_image(0);
+
+    double start = omp_get_wtime();
+
+    #pragma omp parallel
+    {
+        for (int i = next_image.fetch_add(1); i < num_images; i = next_image.fetch_add(1)) {
+            const GrayImage& image = images[i];
+            Opening_Sequential_Separable(image.pixels, results[i], image.width, image.height, kernel_size);
+        }
+    }
+
+    BatchTiming timing;
+    timing.wall_time = omp_get_wtime() - start;
+    timing.images = num_images;
+    return timing;
+}
+
+BatchTiming Opening_Batch_Intra(const std::vector<GrayImage>& images,
+                                std::vector<std::vector<unsigned char>>& results,
+                                const int kernel_size) {
+
+    const int num_images = static_cast<int>(images.size());
+    results.resize(num_images);
+
+    double start = omp_get_wtime();
+
+    for (int i = 0; i < num_images; ++i) {
+        const GrayImage& image = images[i];
+        Opening_Parallel(image.pixels, results[i], image.width, image.height, kernel_size);
+    }
+
+    BatchTiming timing;
+    timing.wall_time = omp_get_wtime() - start;
+    timing.images = num_images;
+    return timing;
+}
+
+BatchTiming Opening_Batch_Intra_Separable(const std::vector<GrayImage>& images,
+                                          std::vector<std::vector<unsigned char>>& results,
+                                          const int kernel_size) {
+
+    const int num_images = static_cast<int>(images.size());
+    results.resize(num_images);
+
+    double start = omp_get_wtime();
+
+    for (int i = 0; i < num_images; ++i) {
+        const GrayImage& image = images[i];
+        Opening_ROI_Parallel(image.pixels, results[i], image.width, image.height, kernel_size,
+                             Rect{0, 0, image.width, image.height});
+    }
+
+    BatchTiming timing;
+    timing.wall_time = omp_get_wtime() - start;
+    timing.images = num_images;
+    return timing;
+}
+
+// Columns per taskloop iteration in the vertical passes
+static const int HYBRID_COLUMN_BLOCK = 64;
+
+// One separable stage of a large image, split into tasks for the current team
+static void separable_stage_tasks(const std::vector<unsigned char>& input,
+                                  std::vector<unsigned char>& output,
+                                  std::vector<unsigned char>& rows,
+                                  const int width, const int height,
+                                  const int kernel_radius, const bool erode) {
+
+    rows.resize(width * height);
+    output.resize(width * height);
+    const int column_blocks = (width + HYBRID_COLUMN_BLOCK - 1) / HYBRID_COLUMN_BLOCK;
+
+    #pragma omp taskloop shared(input, output, rows)
+    for (int i = 0; i < height; ++i) {
+        static thread_local VanHerkScratch scratch;
+        if (erode) erode_1d(&input[i * width], 1, &rows[i * width], 1, width, kernel_radius, scratch);
+        else       dilate_1d(&input[i * width], 1, &rows[i * width], 1, width, kernel_radius, scratch);
+    }
+
+    #pragma omp taskloop shared(input, output, rows)
+    for (int b = 0; b < column_blocks; ++b) {
+        static thread_local VanHerkScratch scratch;
+        const int j1 = std::min(width, (b + 1) * HYBRID_COLUMN_BLOCK);
+        for (int j = b * HYBRID_COLUMN_BLOCK; j < j1; ++j) {
+            if (erode) erode_1d(&rows[j], width, &output[j], width, height, kernel_radius, scratch);
+            else       dilate_1d(&rows[j], width, &output[j], width, height, kernel_radius, scratch);
+        }
+    }
+}
+
+BatchTiming Opening_Batch_Hybrid(const std::vector<GrayImage>& images,
+                                 std::vector<std::vector<unsigned char>>& results,
+                                 const int kernel_size,
+                                 const long long large_image_pixels) {
+
+    const int num_images = static_cast<int>(images.size());
+    results.resize(num_images);
+
+    // largest first, so small images fill the gaps at the end
+    std::vector<int> order(num_images);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) {
+        return static_cast<long long>(images[a].width) * images[a].height >
+               static_cast<long long>(images[b].width) * images[b].height;
+    });
+
+    long long total_pixels = 0;
+    for (const GrayImage& image : images) total_pixels += static_cast<long long>(image.width) * image.height;
+    const long long threshold = large_image_pixels > 0
+        ? large_image_pixels
+        : std::max(1LL, total_pixels / omp_get_max_threads());
+
+    const int kernel_radius = kernel_size / 2;
+
+    double start = omp_get_wtime();
+
+    #pragma omp parallel
+    #pragma omp single
+    {
+        std::vector<unsigned char> rows, temp;
+
+        for (int idx : order) {
+            const GrayImage& image = images[idx];
+            const long long pixels = static_cast<long long>(image.width) * image.height;
+
+            if (pixels > threshold) {
+                // whole team on this image; the taskloops wait for their tasks
+                separable_stage_tasks(image.pixels, temp, rows, image.width, image.height, kernel_radius, true);
+                separable_stage_tasks(temp, results[idx], rows, image.width, image.height, kernel_radius, false);
+            } else {
+                #pragma omp task firstprivate(idx)
+                Opening_Sequential_Separable(images[idx].pixels, results[idx],
+                                             images[idx].width, images[idx].height, kernel_size);
+            }
+        }
+    }
+
+    BatchTiming timing;
+    timing.wall_time = omp_get_wtime() - start;
+    timing.images = num_images;
+    return timing;
+}
@@ -0,0 +1,51 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <vector>
+
+// --- PROCESAMIENTO POR LOTES (paralelismo entre imágenes) ---
+
+struct GrayImage {
+    std::vector<unsigned char> pixels;
+    int width = 0;
+    int height = 0;
+};
+
+struct BatchTiming {
+    double wall_time = 0.0;  // seconds
+    int images = 0;
+
+    double images_per_second() const {
+        return wall_time > 0.0 ? images / wall_time : 0.0;
+    }
+};
+
+// Throughput mode: every thread takes whole images from a shared queue and
+// opens them with Opening_Sequential_Separable (one fork/join per batch)
+BatchTiming Opening_Batch_Throughput(const std::vector<GrayImage>& images,
+                                     std::vector<std::vector<unsigned char>>& results,
+                                     const int kernel_size);
+
+// Intra-image mode: images one after another, each with Opening_Parallel
+BatchTiming Opening_Batch_Intra(const std::vector<GrayImage>& images,
+                                std::vector<std::vector<unsigned char>>& results,
+                                const int kernel_size);
+
+// Intra-image mode with the separable van Herk kernel of the inter mode
+// (Opening_ROI_Parallel over the whole image), so intra vs inter compares
+// only how the work is scheduled
+BatchTiming Opening_Batch_Intra_Separable(const std::vector<GrayImage>& images,
+                                          std::vector<std::vector<unsigned char>>& results,
+                                          const int kernel_size);
+
+// Hybrid mode for mixed sizes: images are sorted by size; images larger
+// than large_image_pixels are split across the whole team (taskloops over
+// rows/columns), smaller ones run one per task, largest first. The default
+// threshold (0) is the per-thread share of all pixels: anything bigger would
+// be a straggler if it ran on one thread.
+BatchTiming Opening_Batch_Hybrid(const std::vector<GrayImage>& images,
+                                 std::vector<std::vector<unsigned char>>& results,
+                                 const int kernel_size,
+                                 const long long large_image_pixels = 0);
+
+#endif // BATCH_H
@@ -0,0 +1,286 @@
+#include "binary.h"
+#include <algorithm>
+#include <omp.h>
+
+// Columns handled per task in the vertical prefix pass
+static const int INTEGRAL_COLUMN_BLOCK = 256;
+
+// Row prefix sums (parallel over rows), then column prefix sums (parallel
+// over column blocks, walking rows so every access stays sequential)
+void Build_Integral_Parallel(const std::vector<unsigned char>& mask,
+                             IntegralImage& integral,
+                             const int width, const int height) {
+
+    const int stride = width + 1;
+    integral.width = width;
+    integral.height = height;
+    integral.sum.assign(static_cast<size_t>(stride) * (height + 1), 0);
+    uint32_t* sum = integral.sum.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        uint32_t* row = sum + static_cast<size_t>(y + 1) * stride;
+        const unsigned char* in = &mask[static_cast<size_t>(y) * width];
+        uint32_t acc = 0;
+        for (int x = 0; x < width; ++x) {
+            acc += in[x] != 0;
+            row[x + 1] = acc;
+        }
+    }
+
+    const int num_blocks = (stride + INTEGRAL_COLUMN_BLOCK - 1) / INTEGRAL_COLUMN_BLOCK;
+
+    #pragma omp parallel for schedule(static)
+    for (int b = 0; b < num_blocks; ++b) {
+        const int x0 = b * INTEGRAL_COLUMN_BLOCK;
+        const int x1 = std::min(stride, x0 + INTEGRAL_COLUMN_BLOCK);
+        for (int y = 2; y <= height; ++y) {
+            uint32_t* row = sum + static_cast<size_t>(y) * stride;
+            const uint32_t* above = row - stride;
+            for (int x = x0; x < x1; ++x) {
+                row[x] += above[x];
+            }
+        }
+    }
+}
+
+// Counts foreground and pixels of the clipped rectangle anchored `before`
+// pixels left/up of each output pixel, then applies `decide(count, area)`
+template <typename Decide>
+static void rectangle_query(const IntegralImage& integral,
+                            std::vector<unsigned char>& output,
+                            const int rect_width, const int rect_height,
+                            const int before_x, const int before_y, Decide decide) {
+
+    const int width = integral.width;
+    const int height = integral.height;
+    const int stride = width + 1;
+    const uint32_t* sum = integral.sum.data();
+    output.resize(static_cast<size_t>(width) * height);
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const int y0 = std::max(0, y - before_y);
+        const int y1 = std::min(height, y - before_y + rect_height);
+        const uint32_t* top = sum + static_cast<size_t>(y0) * stride;
+        const uint32_t* bottom = sum + static_cast<size_t>(y1) * stride;
+
+        for (int x = 0; x < width; ++x) {
+            const int x0 = std::max(0, x - before_x);
+            const int x1 = std::min(width, x - before_x + rect_width);
+            const uint32_t count = bottom[x1] - bottom[x0] - top[x1] + top[x0];
+            const uint32_t area = static_cast<uint32_t>((x1 - x0) * (y1 - y0));
+            output[static_cast<size_t>(y) * width + x] = decide(count, area) ? 255 : 0;
+        }
+    }
+}
+
+void Erode_Binary_Integral(const IntegralImage& integral,
+                           std::vector<unsigned char>& output,
+                           const int rect_width, const int rect_height) {
+
+    rectangle_query(integral, output, rect_width, rect_height, rect_width / 2, rect_height / 2,
+                    [](uint32_t count, uint32_t area) { return count == area; });
+}
+
+void Dilate_Binary_Integral(const IntegralImage& integral,
+                            std::vector<unsigned char>& output,
+                            const int rect_width, const int rect_height) {
+
+    rectangle_query(integral, output, rect_width, rect_height, rect_width / 2, rect_height / 2,
+                    [](uint32_t count, uint32_t) { return count > 0; });
+}
+
+void Opening_Binary_Parallel(const std::vector<unsigned char>& mask,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height,
+                             const int rect_width, const int rect_height) {
+
+    IntegralImage integral;
+    std::vector<unsigned char> eroded;
+
+    Build_Integral_Parallel(mask, integral, width, height);
+    Erode_Binary_Integral(integral, eroded, rect_width, rect_height);
+
+    // dilation by the reflected rectangle: same as the erosion one for odd sizes
+    Build_Integral_Parallel(eroded, integral, width, height);
+    rectangle_query(integral, output, rect_width, rect_height,
+                    rect_width - 1 - rect_width / 2, rect_height - 1 - rect_height / 2,
+                    [](uint32_t count, uint32_t) { return count > 0; });
+}
+
+void Histogram_Parallel(const std::vector<unsigned char>& input,
+                        std::vector<long long>& histogram) {
+
+    const int n = static_cast<int>(input.size());
+    histogram.assign(256, 0);
+
+    #pragma omp parallel
+    {
+        long long local[256] = {};
+
+        #pragma omp for schedule(static) nowait
+        for (int i = 0; i < n; ++i) {
+            local[input[i]]++;
+        }
+
+        #pragma omp critical
+        for (int v = 0; v < 256; ++v) {
+            histogram[v] += local[v];
+        }
+    }
+}
+
+int Otsu_Threshold(const std::vector<long long>& histogram) {
+    long long total = 0;
+    double sum_all = 0.0;
+    for (int v = 0; v < 256; ++v) {
+        total += histogram[v];
+        sum_all += static_cast<double>(v) * histogram[v];
+    }
+
+    long long count_bg = 0;
+    double sum_bg = 0.0;
+    double best_var = -1.0;
+    int best_t = 0;
+
+    for (int t = 0; t < 255; ++t) {
+        count_bg += histogram[t];
+        sum_bg += static_cast<double>(t) * histogram[t];
+        const long long count_fg = total - count_bg;
+        if (count_bg == 0 || count_fg == 0) continue;
+
+        const double mean_bg = sum_bg / count_bg;
+        const double mean_fg = (sum_all - sum_bg) / count_fg;
+        const double between = static_cast<double>(count_bg) * count_fg * (mean_bg - mean_fg) * (mean_bg - mean_fg);
+        if (between > best_var) {
+            best_var = between;
+            best_t = t;
+        }
+    }
+    return best_t;
+}
+
+static void init_bitmask(BitMask& mask, const int width, const int height) {
+    mask.width = width;
+    mask.height = height;
+    mask.words_per_row = (width + 63) / 64;
+    mask.bits.assign(static_cast<size_t>(mask.words_per_row) * height, 0);
+}
+
+void Threshold_BitMask_Parallel(const std::vector<unsigned char>& input,
+                                BitMask& mask,
+                                const int width, const int height, const int threshold) {
+
+    init_bitmask(mask, width, height);
+    const int words = mask.words_per_row;
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* row = &input[static_cast<size_t>(y) * width];
+        uint64_t* out = &mask.bits[static_cast<size_t>(y) * words];
+        for (int w = 0; w < words; ++w) {
+            const int x0 = w * 64;
+            const int x1 = std::min(width, x0 + 64);
+            uint64_t word = 0;
+            for (int x = x0; x < x1; ++x) {
+                word |= static_cast<uint64_t>(row[x] > threshold) << (x - x0);
+            }
+            out[w] = word;
+        }
+    }
+}
+
+// 64 bits of `row` starting at bit w * 64 + shift; bits outside the row
+// (including the padding of the last word) read as `fill`
+static inline uint64_t shifted_word(const uint64_t* row, const int words, const uint64_t pad_mask,
+                                    const int w, const int shift, const uint64_t fill) {
+    auto word_at = [&](int k) -> uint64_t {
+        if (k < 0 || k >= words) return fill;
+        return k == words - 1 ? (row[k] | (fill & pad_mask)) : row[k];
+    };
+    const int pos = w * 64 + shift;
+    const int q = pos >= 0 ? pos / 64 : -((-pos + 63) / 64);
+    const int off = pos - q * 64;
+    if (off == 0) return word_at(q);
+    return (word_at(q) >> off) | (word_at(q + 1) << (64 - off));
+}
+
+// Horizontal then vertical pass of a square erosion (AND) or dilation (OR)
+static void bitmask_filter(const BitMask& input, BitMask& output, const int radius, const bool erode) {
+    const int width = input.width;
+    const int height = input.height;
+    const int words = input.words_per_row;
+    const int tail_bits = width % 64;
+    const uint64_t pad_mask = tail_bits ? ~((uint64_t(1) << tail_bits) - 1) : 0;
+    const uint64_t fill = erode ? ~uint64_t(0) : 0;
+
+    BitMask horiz;
+    init_bitmask(horiz, width, height);
+    init_bitmask(output, width, height);
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const uint64_t* row = &input.bits[static_cast<size_t>(y) * words];
+        uint64_t* out = &horiz.bits[static_cast<size_t>(y) * words];
+        for (int w = 0; w < words; ++w) {
+            uint64_t acc = row[w] | (w == words - 1 ? (fill & pad_mask) : 0);
+            for (int s = 1; s <= radius; ++s) {
+                const uint64_t left = shifted_word(row, words, pad_mask, w, -s, fill);
+                const uint64_t right = shifted_word(row, words, pad_mask, w, s, fill);
+                acc = erode ? (acc & left & right) : (acc | left | right);
+            }
+            out[w] = (w == words - 1) ? (acc & ~pad_mask) : acc;
+        }
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const int y0 = std::max(0, y - radius);
+        const int y1 = std::min(height - 1, y + radius);
+        uint64_t* out = &output.bits[static_cast<size_t>(y) * words];
+        for (int w = 0; w < words; ++w) {
+            uint64_t acc = horiz.bits[static_cast<size_t>(y0) * words + w];
+            for (int r = y0 + 1; r <= y1; ++r) {
+                const uint64_t v = horiz.bits[static_cast<size_t>(r) * words + w];
+                acc = erode ? (acc & v) : (acc | v);
+            }
+            out[w] = acc;
+        }
+    }
+}
+
+void Opening_BitMask_Parallel(const BitMask& input, BitMask& output, const int kernel_size) {
+    BitMask eroded;
+    bitmask_filter(input, eroded, kernel_size / 2, true);
+    bitmask_filter(eroded, output, kernel_size / 2, false);
+}
+
+int Threshold_Opening_Parallel(const std::vector<unsigned char>& input,
+                               BitMask& output,
+                               const int width, const int height, const int kernel_size,
+                               const int threshold) {
+
+    int t = threshold;
+    if (t < 0) {
+        std::vector<long long> histogram;
+        Histogram_Parallel(input, histogram);
+        t = Otsu_Threshold(histogram);
+    }
+
+    BitMask mask;
+    Threshold_BitMask_Parallel(input, mask, width, height, t);
+    Opening_BitMask_Parallel(mask, output, kernel_size);
+    return t;
+}
+
+void BitMask_To_Bytes(const BitMask& mask, std::vector<unsigned char>& output) {
+    output.resize(static_cast<size_t>(mask.width) * mask.height);
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < mask.height; ++y) {
+        for (int x = 0; x < mask.width; ++x) {
+            output[static_cast<size_t>(y) * mask.width + x] = mask.get(x, y) ? 255 : 0;
+        }
+    }
+}
@@ -0,0 +1,86 @@
+#ifndef BINARY_H
+#define BINARY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// --- MORFOLOGÍA BINARIA CON IMAGEN INTEGRAL ---
+//
+// Masks are 0 = background, anything else = foreground; results are 0/255.
+// A w x h rectangle covers [x - w/2, x - w/2 + w) x [y - h/2, y - h/2 + h),
+// clipped to the image like the grayscale kernels, so odd sizes match
+// Erode_Parallel/Dilate_Parallel with kernel_size = w = h. Once the integral
+// image is built every rectangle query is O(1), for any rectangle size.
+
+struct IntegralImage {
+    int width = 0;
+    int height = 0;
+    // (width + 1) x (height + 1); sum[y * (width + 1) + x] counts the
+    // foreground pixels in [0, x) x [0, y)
+    std::vector<uint32_t> sum;
+};
+
+void Build_Integral_Parallel(const std::vector<unsigned char>& mask,
+                             IntegralImage& integral,
+                             const int width, const int height);
+
+// Foreground where the whole (clipped) rectangle is foreground
+void Erode_Binary_Integral(const IntegralImage& integral,
+                           std::vector<unsigned char>& output,
+                           const int rect_width, const int rect_height);
+
+// Foreground where any pixel of the (clipped) rectangle is foreground
+void Dilate_Binary_Integral(const IntegralImage& integral,
+                            std::vector<unsigned char>& output,
+                            const int rect_width, const int rect_height);
+
+// Erosion followed by dilation with the reflected rectangle (a true opening
+// for even sizes as well)
+void Opening_Binary_Parallel(const std::vector<unsigned char>& mask,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height,
+                             const int rect_width, const int rect_height);
+
+// --- UMBRAL + APERTURA BINARIA SOBRE MÁSCARAS EMPAQUETADAS ---
+//
+// One bit per pixel, 64 pixels per word, rows padded to whole words (padding
+// bits are always 0). Square kernels with the same clipping as the grayscale
+// kernels, evaluated 64 pixels per operation.
+
+struct BitMask {
+    int width = 0;
+    int height = 0;
+    int words_per_row = 0;
+    std::vector<uint64_t> bits;
+
+    bool get(const int x, const int y) const {
+        return (bits[static_cast<size_t>(y) * words_per_row + x / 64] >> (x % 64)) & 1u;
+    }
+};
+
+// 256-bin histogram from thread-private histograms merged at the end
+void Histogram_Parallel(const std::vector<unsigned char>& input,
+                        std::vector<long long>& histogram);
+
+// Otsu threshold t: foreground is value > t
+int Otsu_Threshold(const std::vector<long long>& histogram);
+
+void Threshold_BitMask_Parallel(const std::vector<unsigned char>& input,
+                                BitMask& mask,
+                                const int width, const int height, const int threshold);
+
+void Opening_BitMask_Parallel(const BitMask& input, BitMask& output, const int kernel_size);
+
+// Fused pipeline: histogram -> threshold (Otsu when threshold < 0) ->
+// bit-packed mask -> binary opening. No 8-bit thresholded image is ever
+// written. Returns the threshold used.
+int Threshold_Opening_Parallel(const std::vector<unsigned char>& input,
+                               BitMask& output,
+                               const int width, const int height, const int kernel_size,
+                               const int threshold = -1);
+
+// Expands a mask to 0/255 bytes
+void BitMask_To_Bytes(const BitMask& mask, std::vector<unsigned char>& output);
+
+#endif // BINARY_H
@@ -1,6 +1,6 @@
 @echo off
 echo Compilant projecte...
-g++ -fopenmp -O2 -std=c++17 main.cpp sequential.cpp parallel.cpp -o main.exe
+g++ -fopenmp -O2 -std=c++17 main.cpp sequential.cpp parallel.cpp streaming.cpp line_se.cpp path_opening.cpp incremental.cpp roi.cpp binary.cpp adaptive.cpp tile_skip.cpp temporal.cpp pyramid.cpp watershed.cpp reconstruction.cpp labeling.cpp distance.cpp batch.cpp thread_pool.cpp pool_parallel.cpp numa.cpp image_utils.cpp pipeline.cpp fused.cpp autotune.cpp sharded.cpp -o main.exe
 if %errorlevel% == 0 (
     echo Compilacio completada correctament!
     echo Executable: main.exe
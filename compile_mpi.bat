@@ -0,0 +1,10 @@
+@echo off
+echo Compilant projecte (MPI)...
+mpicxx -fopenmp -O2 -std=c++17 mpi_main.cpp sequential.cpp roi.cpp image_utils.cpp -o mpi_main.exe
+if %errorlevel% == 0 (
+    echo Compilacio completada correctament!
+    echo Executable: mpi_main.exe
+) else (
+    echo ERROR en la compilacio!
+)
+pause
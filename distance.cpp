@@ -0,0 +1,119 @@
+#include "distance.h"
+#include <algorithm>
+#include <omp.h>
+
+namespace {
+
+// floor(a / b) for b > 0
+inline long long floor_div(const long long a, const long long b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+// Shared core: foreground given as a predicate on the pixel index
+template <typename IsForeground>
+void meijster(const int width, const int height, IsForeground is_foreground,
+              std::vector<uint32_t>* distance, std::vector<int>* nearest) {
+
+    const int n = width * height;
+    const int inf = width + height;  // larger than any real distance along an axis
+    std::vector<int> g(n);           // vertical distance to the nearest foreground in the column
+    std::vector<int> g_row;          // ... and that foreground pixel's row
+    if (nearest) g_row.resize(n);
+
+    if (distance) distance->resize(n);
+    if (nearest) nearest->resize(n);
+
+    // phase 1: columns
+    #pragma omp parallel for schedule(static)
+    for (int x = 0; x < width; ++x) {
+        int last = -1;
+        for (int y = 0; y < height; ++y) {
+            const int p = y * width + x;
+            if (is_foreground(p)) last = y;
+            g[p] = last >= 0 ? y - last : inf;
+            if (nearest) g_row[p] = last;
+        }
+        last = -1;
+        for (int y = height - 1; y >= 0; --y) {
+            const int p = y * width + x;
+            if (is_foreground(p)) last = y;
+            if (last >= 0 && last - y < g[p]) {
+                g[p] = last - y;
+                if (nearest) g_row[p] = last;
+            }
+        }
+    }
+
+    // phase 2: rows, lower envelope of the parabolas (x - i)^2 + g(i)^2
+    #pragma omp parallel
+    {
+        std::vector<int> s(width), t(width);
+
+        #pragma omp for schedule(static)
+        for (int y = 0; y < height; ++y) {
+            const int* gy = &g[static_cast<size_t>(y) * width];
+            auto f = [&](long long x, int i) { return (x - i) * (x - i) + static_cast<long long>(gy[i]) * gy[i]; };
+            auto sep = [&](int i, int u) {
+                const long long num = static_cast<long long>(u) * u - static_cast<long long>(i) * i
+                                    + static_cast<long long>(gy[u]) * gy[u] - static_cast<long long>(gy[i]) * gy[i];
+                return floor_div(num, 2LL * (u - i));
+            };
+
+            int q = 0;
+            s[0] = 0;
+            t[0] = 0;
+            for (int u = 1; u < width; ++u) {
+                while (q >= 0 && f(t[q], s[q]) > f(t[q], u)) q--;
+                if (q < 0) {
+                    q = 0;
+                    s[0] = u;
+                } else {
+                    const long long w = 1 + sep(s[q], u);
+                    if (w < width) {
+                        q++;
+                        s[q] = u;
+                        t[q] = static_cast<int>(w);
+                    }
+                }
+            }
+
+            for (int u = width - 1; u >= 0; --u) {
+                const int i = s[q];
+                const int p = y * width + u;
+                const bool found = gy[i] < inf;
+                if (distance) (*distance)[p] = found ? static_cast<uint32_t>(f(u, i)) : UINT32_MAX;
+                if (nearest) (*nearest)[p] = found ? g_row[static_cast<size_t>(y) * width + i] * width + i : -1;
+                if (u == t[q]) q--;
+            }
+        }
+    }
+}
+
+} // namespace
+
+void Distance_Transform_Parallel(const std::vector<unsigned char>& input,
+                                 std::vector<uint32_t>& distance,
+                                 const int width, const int height,
+                                 const int threshold,
+                                 std::vector<int>* nearest) {
+
+    const unsigned char* f = input.data();
+    meijster(width, height, [f, threshold](int p) { return f[p] > threshold; }, &distance, nearest);
+}
+
+void SKIZ_Parallel(const std::vector<int>& labels,
+                   std::vector<int>& zones,
+                   const int width, const int height) {
+
+    const int n = width * height;
+    const int* l = labels.data();
+    std::vector<int> nearest;
+    meijster(width, height, [l](int p) { return l[p] > 0; }, nullptr, &nearest);
+
+    zones.resize(n);
+
+    #pragma omp parallel for schedule(static)
+    for (int p = 0; p < n; ++p) {
+        zones[p] = nearest[p] >= 0 ? labels[nearest[p]] : 0;
+    }
+}
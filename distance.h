@@ -0,0 +1,27 @@
+#ifndef DISTANCE_H
+#define DISTANCE_H
+
+#include <cstdint>
+#include <vector>
+
+// --- TRANSFORMADA DE DISTANCIA EUCLÍDEA EXACTA (Meijster) ---
+//
+// Squared Euclidean distance from every pixel to the nearest foreground
+// pixel (input > threshold); 0 on foreground, UINT32_MAX when the image has
+// no foreground. Phase 1 runs in parallel over columns, phase 2 over rows.
+
+// `nearest` (optional) receives the index y * width + x of the nearest
+// foreground pixel (feature transform), -1 when there is none
+void Distance_Transform_Parallel(const std::vector<unsigned char>& input,
+                                 std::vector<uint32_t>& distance,
+                                 const int width, const int height,
+                                 const int threshold = 0,
+                                 std::vector<int>* nearest = nullptr);
+
+// Skeleton by influence zones: every pixel gets the label of the nearest
+// pixel with label > 0 (Voronoi partition of the labelled regions)
+void SKIZ_Parallel(const std::vector<int>& labels,
+                   std::vector<int>& zones,
+                   const int width, const int height);
+
+#endif // DISTANCE_H
@@ -0,0 +1,136 @@
+#include "fused.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <omp.h>
+
+namespace {
+
+struct Stage {
+    bool dilate;
+    int radius;
+};
+
+// Same window as Dilate_Parallel / Erode_Parallel on rows [row_begin, row_end)
+void filter_rows(const unsigned char* input, unsigned char* output,
+                 const int width, const int height, const Stage& stage,
+                 const int row_begin, const int row_end) {
+
+    const int kernel_radius = stage.radius;
+
+    for (int i = row_begin; i < row_end; ++i) {
+        for (int j = 0; j < width; ++j) {
+            unsigned char best = stage.dilate ? 0 : 255;
+
+            for (int u = -kernel_radius; u <= kernel_radius; ++u) {
+                for (int v = -kernel_radius; v <= kernel_radius; ++v) {
+                    int ni = i + u;
+                    int nj = j + v;
+
+                    if (ni >= 0 && ni < height && nj >= 0 && nj < width) {
+                        unsigned char current_pixel = input[ni * width + nj];
+                        if (stage.dilate ? current_pixel > best : current_pixel < best) {
+                            best = current_pixel;
+                        }
+                    }
+                }
+            }
+            output[i * width + j] = best;
+        }
+    }
+}
+
+// Runs the stage chain in one parallel region. Stage s writes ping-pong
+// buffer s % 2 (the last one writes `output`), so band b of stage s must
+// wait until stage s-1 is done on every band within max(r_s, r_{s-1}) rows:
+// r_s for the rows it reads, r_{s-1} so nobody still reads what it overwrites.
+void run_stages(const std::vector<unsigned char>& input,
+                std::vector<unsigned char>& output,
+                const int width, const int height,
+                const std::vector<Stage>& stages) {
+
+    const int num_pixels = width * height;
+    output.resize(num_pixels);
+    if (num_pixels == 0) return;
+    if (stages.empty()) {
+        output = input;
+        return;
+    }
+
+    const int num_stages = static_cast<int>(stages.size());
+    std::vector<unsigned char> buffers[2];
+    if (num_stages > 1) buffers[0].resize(num_pixels);
+    if (num_stages > 2) buffers[1].resize(num_pixels);
+
+    // a few bands per thread so neighbours can start early
+    const int num_bands = std::min(height, 4 * omp_get_max_threads());
+    const int band_height = (height + num_bands - 1) / num_bands;
+    const int bands = (height + band_height - 1) / band_height;
+
+    // done[s * bands + b] != 0 once band b of stage s is written
+    std::vector<std::atomic<int>> done(static_cast<size_t>(num_stages) * bands);
+    for (std::atomic<int>& flag : done) flag.store(0, std::memory_order_relaxed);
+
+    #pragma omp parallel
+    {
+        const int t = omp_get_thread_num();
+        const int num_threads = omp_get_num_threads();
+        const int first_band = static_cast<int>(static_cast<long long>(bands) * t / num_threads);
+        const int last_band = static_cast<int>(static_cast<long long>(bands) * (t + 1) / num_threads);
+
+        for (int s = 0; s < num_stages; ++s) {
+            const unsigned char* src = s == 0 ? input.data() : buffers[(s - 1) % 2].data();
+            unsigned char* dst = s == num_stages - 1 ? output.data() : buffers[s % 2].data();
+            const int halo = s == 0 ? 0 : std::max(stages[s].radius, stages[s - 1].radius);
+
+            for (int b = first_band; b < last_band; ++b) {
+                const int row_begin = b * band_height;
+                const int row_end = std::min(height, row_begin + band_height);
+
+                if (s > 0) {
+                    const int dep_first = std::max(0, row_begin - halo) / band_height;
+                    const int dep_last = std::min(height - 1, row_end - 1 + halo) / band_height;
+                    for (int d = dep_first; d <= dep_last; ++d) {
+                        const std::atomic<int>& flag = done[static_cast<size_t>(s - 1) * bands + d];
+                        while (!flag.load(std::memory_order_acquire)) std::this_thread::yield();
+                    }
+                }
+
+                filter_rows(src, dst, width, height, stages[s], row_begin, row_end);
+                done[static_cast<size_t>(s) * bands + b].store(1, std::memory_order_release);
+            }
+        }
+    }
+}
+
+} // namespace
+
+void Opening_Parallel_Fused(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height, const int kernel_size) {
+
+    const int kernel_radius = kernel_size / 2;
+    run_stages(input, output, width, height, {{false, kernel_radius}, {true, kernel_radius}});
+}
+
+void Closing_Parallel_Fused(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height, const int kernel_size) {
+
+    const int kernel_radius = kernel_size / 2;
+    run_stages(input, output, width, height, {{true, kernel_radius}, {false, kernel_radius}});
+}
+
+void ASF_Parallel_Fused(const std::vector<unsigned char>& input,
+                        std::vector<unsigned char>& output,
+                        const int width, const int height, const int max_kernel_size) {
+
+    std::vector<Stage> stages;
+    for (int radius = 1; 2 * radius + 1 <= max_kernel_size; ++radius) {
+        stages.push_back({false, radius});  // opening
+        stages.push_back({true, radius});
+        stages.push_back({true, radius});   // closing
+        stages.push_back({false, radius});
+    }
+    run_stages(input, output, width, height, stages);
+}
@@ -0,0 +1,31 @@
+#ifndef FUSED_H
+#define FUSED_H
+
+#include <vector>
+
+// --- OPERACIONES MULTIETAPA EN UNA SOLA REGIÓN PARALELA ---
+//
+// Opening_Parallel opens two parallel regions with a full barrier between
+// erosion and dilation. Here every stage runs inside one region: the image
+// is cut into bands of rows, each thread owns a contiguous run of bands and
+// a band of stage s starts as soon as the bands of stage s-1 within its
+// window halo are done (per-band atomic flags, no barriers). Two ping-pong
+// buffers hold the intermediate stages. Results are identical to the
+// stage-by-stage versions.
+
+void Opening_Parallel_Fused(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height, const int kernel_size);
+
+// Closing = dilation followed by erosion
+void Closing_Parallel_Fused(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height, const int kernel_size);
+
+// Alternating sequential filter: opening then closing for kernel sizes
+// 3, 5, ..., max_kernel_size (4 stages per size, all in the same region)
+void ASF_Parallel_Fused(const std::vector<unsigned char>& input,
+                        std::vector<unsigned char>& output,
+                        const int width, const int height, const int max_kernel_size);
+
+#endif // FUSED_H
@@ -0,0 +1,21 @@
+#include "image_utils.h"
+#include <cmath>
+
+// RGB to grayscale conversion
+std::vector<unsigned char> convert_to_grayscale(unsigned char* data, int width, int height, int n_channels) {
+    std::vector<unsigned char> grayscale_data;
+    grayscale_data.reserve(width * height);
+
+    for (int i = 0; i < width * height; ++i) {
+        if (n_channels >= 3) {
+            unsigned char r = data[i * n_channels];
+            unsigned char g = data[i * n_channels + 1];
+            unsigned char b = data[i * n_channels + 2];
+            unsigned char gray = static_cast<unsigned char>(std::round(0.299f * r + 0.587f * g + 0.114f * b));
+            grayscale_data.push_back(gray);
+        } else if (n_channels == 1) {
+            grayscale_data.push_back(data[i]);
+        }
+    }
+    return grayscale_data;
+}
@@ -0,0 +1,11 @@
+#ifndef IMAGE_UTILS_H
+#define IMAGE_UTILS_H
+
+#include <vector>
+
+// --- UTILIDADES DE IMAGEN ---
+
+// RGB to grayscale conversion (1-channel data is copied as is)
+std::vector<unsigned char> convert_to_grayscale(unsigned char* data, int width, int height, int n_channels);
+
+#endif // IMAGE_UTILS_H
@@ -0,0 +1,51 @@
+#include "incremental.h"
+#include "parallel.h"
+#include "roi.h"
+#include <algorithm>
+#include <omp.h>
+
+void Opening_Incremental_Parallel(const std::vector<unsigned char>& input,
+                                  std::vector<unsigned char>& output,
+                                  const int width, const int height, const int kernel_size,
+                                  const std::vector<Rect>& dirty_rects) {
+
+    if (static_cast<int>(output.size()) != width * height) {
+        Opening_Parallel(input, output, width, height, kernel_size);
+        return;
+    }
+
+    // affected output = dirty rect grown by the erosion and the dilation radius
+    const int kernel_radius = kernel_size / 2;
+    std::vector<Rect> regions;
+    for (const Rect& dirty : dirty_rects) {
+        Rect r = clip_rect(expand_rect(dirty, 2 * kernel_radius), width, height);
+        if (rect_empty(r)) continue;
+
+        // merge with anything it overlaps so no pixel is recomputed twice
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t i = 0; i < regions.size(); ++i) {
+                if (rects_overlap(regions[i], r)) {
+                    r = bounding_rect(regions[i], r);
+                    regions.erase(regions.begin() + i);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        regions.push_back(r);
+    }
+
+    std::vector<unsigned char> patch;
+    for (const Rect& region : regions) {
+        Opening_ROI_Parallel(input, patch, width, height, kernel_size, region);
+
+        #pragma omp parallel for schedule(static)
+        for (int r = 0; r < region.height; ++r) {
+            std::copy(patch.begin() + static_cast<size_t>(r) * region.width,
+                      patch.begin() + static_cast<size_t>(r + 1) * region.width,
+                      output.begin() + static_cast<size_t>(region.y + r) * width + region.x);
+        }
+    }
+}
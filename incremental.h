@@ -0,0 +1,20 @@
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <vector>
+#include "rect.h"
+
+// --- RECÁLCULO INCREMENTAL POR REGIONES MODIFICADAS ---
+//
+// `input` is the current (already edited) image and `output` the opening of
+// the previous input, patched in place. Only output pixels within
+// 2 * kernel_radius of a dirty rectangle can change, so the work scales
+// with the size of the edit. Falls back to a full Opening_Parallel when
+// `output` does not hold a previous result.
+
+void Opening_Incremental_Parallel(const std::vector<unsigned char>& input,
+                                  std::vector<unsigned char>& output,
+                                  const int width, const int height, const int kernel_size,
+                                  const std::vector<Rect>& dirty_rects);
+
+#endif // INCREMENTAL_H
@@ -0,0 +1,174 @@
+#include "labeling.h"
+#include "union_find.h"
+#include <algorithm>
+#include <climits>
+#include <omp.h>
+
+namespace {
+
+// Foreground bits of a 2x2 block: a = top-left, b = top-right,
+// c = bottom-left, d = bottom-right
+struct BlockBits {
+    bool a, b, c, d;
+    bool any() const { return a || b || c || d; }
+};
+
+BlockBits block_bits(const unsigned char* f, const int width, const int height,
+                     const int bx, const int by, const int threshold) {
+    const int x = 2 * bx, y = 2 * by;
+    const bool has_right = x + 1 < width;
+    const bool has_bottom = y + 1 < height;
+    BlockBits bits;
+    bits.a = f[y * width + x] > threshold;
+    bits.b = has_right && f[y * width + x + 1] > threshold;
+    bits.c = has_bottom && f[(y + 1) * width + x] > threshold;
+    bits.d = has_right && has_bottom && f[(y + 1) * width + x + 1] > threshold;
+    return bits;
+}
+
+// Every foreground pixel of a 2x2 block touches every other one, so blocks
+// connect iff their facing pixels do
+void union_with_upper_row(int* parent, const unsigned char* f, const int width, const int height,
+                          const int blocks_x, const int bx, const int by, const BlockBits& cur,
+                          const int threshold) {
+    const int idx = by * blocks_x + bx;
+
+    if (cur.a || cur.b) {
+        const BlockBits up = block_bits(f, width, height, bx, by - 1, threshold);
+        if (up.c || up.d) uf_union(parent, idx, idx - blocks_x);
+    }
+    if (cur.a && bx > 0) {
+        const BlockBits up_left = block_bits(f, width, height, bx - 1, by - 1, threshold);
+        if (up_left.d) uf_union(parent, idx, idx - blocks_x - 1);
+    }
+    if (cur.b && bx + 1 < blocks_x) {
+        const BlockBits up_right = block_bits(f, width, height, bx + 1, by - 1, threshold);
+        if (up_right.c) uf_union(parent, idx, idx - blocks_x + 1);
+    }
+}
+
+} // namespace
+
+int Label_Components_Parallel(const std::vector<unsigned char>& input,
+                              std::vector<int>& labels,
+                              std::vector<ComponentStats>& stats,
+                              const int width, const int height,
+                              const int threshold) {
+
+    labels.assign(width * height, 0);
+    stats.clear();
+    if (width <= 0 || height <= 0) return 0;
+
+    const int blocks_x = (width + 1) / 2;
+    const int blocks_y = (height + 1) / 2;
+    const int num_blocks = blocks_x * blocks_y;
+    const unsigned char* f = input.data();
+
+    std::vector<int> parent(num_blocks);
+    std::vector<int> root(num_blocks);
+    std::vector<unsigned char> foreground(num_blocks);
+    std::vector<int> strip_starts;
+    int* P = parent.data();
+
+    #pragma omp parallel
+    {
+        const int num_threads = omp_get_num_threads();
+        const int t = omp_get_thread_num();
+        const int by0 = static_cast<int>(static_cast<long long>(blocks_y) * t / num_threads);
+        const int by1 = static_cast<int>(static_cast<long long>(blocks_y) * (t + 1) / num_threads);
+
+        #pragma omp single
+        strip_starts.resize(num_threads);
+        strip_starts[t] = by0;
+
+        // local scan: unions stay inside the strip, so no synchronization
+        for (int by = by0; by < by1; ++by) {
+            for (int bx = 0; bx < blocks_x; ++bx) {
+                const int idx = by * blocks_x + bx;
+                const BlockBits cur = block_bits(f, width, height, bx, by, threshold);
+                P[idx] = idx;
+                foreground[idx] = cur.any();
+                if (!cur.any()) continue;
+
+                if (bx > 0 && (cur.a || cur.c)) {
+                    const BlockBits left = block_bits(f, width, height, bx - 1, by, threshold);
+                    if (left.b || left.d) uf_union(P, idx, idx - 1);
+                }
+                if (by > by0) {
+                    union_with_upper_row(P, f, width, height, blocks_x, bx, by, cur, threshold);
+                }
+            }
+        }
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (size_t s = 1; s < strip_starts.size(); ++s) {
+                const int by = strip_starts[s];
+                if (by <= 0 || by >= blocks_y) continue;
+                for (int bx = 0; bx < blocks_x; ++bx) {
+                    const BlockBits cur = block_bits(f, width, height, bx, by, threshold);
+                    if (cur.any()) union_with_upper_row(P, f, width, height, blocks_x, bx, by, cur, threshold);
+                }
+            }
+        }
+
+        #pragma omp for schedule(static)
+        for (int idx = 0; idx < num_blocks; ++idx) {
+            root[idx] = uf_root(P, idx);
+        }
+    }
+
+    // consecutive labels, raster order of the first block of each component
+    std::vector<int> block_label(num_blocks, 0);
+    int count = 0;
+    for (int idx = 0; idx < num_blocks; ++idx) {
+        if (foreground[idx] && root[idx] == idx) block_label[idx] = ++count;
+    }
+
+    stats.resize(count);
+    for (ComponentStats& s : stats) {
+        s.min_x = INT_MAX;
+        s.min_y = INT_MAX;
+        s.max_x = -1;
+        s.max_y = -1;
+    }
+
+    // pixel labels and per-label statistics in one pass, thread-local tables
+    #pragma omp parallel
+    {
+        std::vector<ComponentStats> local(stats);
+
+        #pragma omp for schedule(static)
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                const int p = y * width + x;
+                if (f[p] <= threshold) continue;
+                const int label = block_label[root[(y / 2) * blocks_x + x / 2]];
+                labels[p] = label;
+
+                ComponentStats& s = local[label - 1];
+                s.area++;
+                s.min_x = std::min(s.min_x, x);
+                s.min_y = std::min(s.min_y, y);
+                s.max_x = std::max(s.max_x, x);
+                s.max_y = std::max(s.max_y, y);
+            }
+        }
+
+        #pragma omp critical
+        {
+            for (int l = 0; l < count; ++l) {
+                ComponentStats& s = stats[l];
+                const ComponentStats& ls = local[l];
+                s.area += ls.area;
+                s.min_x = std::min(s.min_x, ls.min_x);
+                s.min_y = std::min(s.min_y, ls.min_y);
+                s.max_x = std::max(s.max_x, ls.max_x);
+                s.max_y = std::max(s.max_y, ls.max_y);
+            }
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,28 @@
+#ifndef LABELING_H
+#define LABELING_H
+
+#include <vector>
+
+// --- ETIQUETADO DE COMPONENTES CONEXAS ---
+//
+// Foreground is input > threshold (0 for 0/255 masks). 8-connectivity,
+// labels 1..n in raster order of each component's first 2x2 block, 0 for
+// background. Block-based union-find (2x2 blocks, Grana-style) on row
+// strips in parallel, seams merged afterwards.
+
+struct ComponentStats {
+    long long area = 0;
+    int min_x = 0;
+    int min_y = 0;
+    int max_x = 0;
+    int max_y = 0;
+};
+
+// stats[label - 1] describes component `label`. Returns the number of components.
+int Label_Components_Parallel(const std::vector<unsigned char>& input,
+                              std::vector<int>& labels,
+                              std::vector<ComponentStats>& stats,
+                              const int width, const int height,
+                              const int threshold = 0);
+
+#endif // LABELING_H
@@ -0,0 +1,235 @@
+#include "line_se.h"
+#include "morph_1d.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <omp.h>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// Longest period tried when approximating the angle by a rational slope;
+// every pixel pays one comparison per segment point, so this bounds the
+// brute-force part of the decomposition
+const int MAX_PERIOD = 8;
+
+// SE = segment (+) {i * v : |i| <= half_count}. The segment is the Bresenham
+// run of one period, so the union is a connected discrete line of about
+// `length` pixels along the dominant axis, identical at every pixel.
+struct LineDecomposition {
+    int vx, vy;                  // period vector (image x right, y down)
+    int half_count;              // periodic line has 2 * half_count + 1 points
+    std::vector<int> seg_x;      // segment offsets, centred on the origin
+    std::vector<int> seg_y;
+};
+
+// m such that 2m + 1 periods of `period` pixels are closest to length
+int half_periods(const int length, const int period) {
+    const double periods = static_cast<double>(length) / period;
+    return std::max(0, static_cast<int>(std::floor((periods - 1.0) / 2.0 + 0.5)));
+}
+
+LineDecomposition make_decomposition(const int length, const double angle_deg) {
+    const double theta = angle_deg * PI / 180.0;
+    const double dx = std::cos(theta);
+    const double dy = -std::sin(theta);  // image rows grow downwards
+    const bool x_major = std::fabs(dx) >= std::fabs(dy);
+    const double slope = x_major ? dy / dx : dx / dy;
+    const double target = std::atan(slope);
+
+    // closest rational slope minor / period whose odd number of periods
+    // spans length within max(1, length / 5) pixels; shortest period on ties
+    // (period 1 always qualifies)
+    const int max_period = std::max(1, std::min(length, MAX_PERIOD));
+    const int tolerance = std::max(1, length / 5);
+    int period = 1;
+    int minor = static_cast<int>(std::floor(slope + 0.5));
+    double best_error = std::fabs(std::atan(static_cast<double>(minor)) - target);
+    for (int k = 2; k <= max_period; ++k) {
+        if (std::abs(2 * half_periods(length, k) * k + k - length) > tolerance) continue;
+        const int j = static_cast<int>(std::floor(k * slope + 0.5));
+        const double error = std::fabs(std::atan(static_cast<double>(j) / k) - target);
+        if (error < best_error - 1e-12) {
+            best_error = error;
+            period = k;
+            minor = j;
+        }
+    }
+
+    LineDecomposition d;
+    d.vx = x_major ? period : minor;
+    d.vy = x_major ? minor : period;
+
+    d.half_count = half_periods(length, period);
+
+    const int centre = (period - 1) / 2;
+    const int centre_minor = static_cast<int>(std::floor(static_cast<double>(centre) * minor / period + 0.5));
+    for (int p = 0; p < period; ++p) {
+        const int q = static_cast<int>(std::floor(static_cast<double>(p) * minor / period + 0.5));
+        d.seg_x.push_back(x_major ? p - centre : q - centre_minor);
+        d.seg_y.push_back(x_major ? q - centre_minor : p - centre);
+    }
+    return d;
+}
+
+// Erosion (min over x + b) or dilation (max over x - b) by the decomposed SE.
+// The image is padded with the neutral value far enough that every x + i v
+// is inside the padded domain; this reproduces the clipped windows of the
+// 2D kernels exactly, and the periodic part becomes a van Herk pass along
+// index stride vy * W + vx.
+template <typename Op>
+void line_stage(const std::vector<unsigned char>& input,
+                std::vector<unsigned char>& output,
+                const int width, const int height,
+                const LineDecomposition& d, const bool reflect) {
+
+    const int sign = reflect ? -1 : 1;
+    const int vx = sign * d.vx;
+    const int vy = sign * d.vy;
+    const int m = d.half_count;
+
+    int seg_ext_x = 0, seg_ext_y = 0;
+    for (size_t s = 0; s < d.seg_x.size(); ++s) {
+        seg_ext_x = std::max(seg_ext_x, std::abs(d.seg_x[s]));
+        seg_ext_y = std::max(seg_ext_y, std::abs(d.seg_y[s]));
+    }
+    const int pad_x = m * std::abs(vx) + seg_ext_x;
+    const int pad_y = m * std::abs(vy) + seg_ext_y;
+    const int pw = width + 2 * pad_x;
+    const int ph = height + 2 * pad_y;
+
+    std::vector<unsigned char> padded(static_cast<size_t>(pw) * ph, Op::identity);
+    std::vector<unsigned char> segment(static_cast<size_t>(pw) * ph);
+    std::vector<unsigned char> filtered(static_cast<size_t>(pw) * ph);
+
+    // A line x, x + v, x + 2v, ... starts where x - v leaves the padded
+    // image: in the |vx| columns it enters through or the |vy| rows it
+    // enters through. Rows are handed out whole, so the starts are never
+    // listed; a row of the row band holds pw starts, any other row |vx|.
+    const int band_x0 = vx > 0 ? 0 : pw + vx;           // columns [band_x0, band_x1)
+    const int band_x1 = vx > 0 ? vx : pw;
+    const int band_y0 = vy > 0 ? 0 : ph + vy;           // rows [band_y0, band_y1)
+    const int band_y1 = vy > 0 ? vy : ph;
+    const int stride = vy * pw + vx;
+
+    // points of the line starting at (x, y) inside the padded image
+    auto line_length = [&](const int x, const int y) {
+        int n = pw + ph;
+        if (vx > 0) n = std::min(n, (pw - 1 - x) / vx + 1);
+        if (vx < 0) n = std::min(n, x / -vx + 1);
+        if (vy > 0) n = std::min(n, (ph - 1 - y) / vy + 1);
+        if (vy < 0) n = std::min(n, y / -vy + 1);
+        return n;
+    };
+
+    #pragma omp parallel
+    {
+        const Op op;
+        VanHerkScratch scratch;
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < height; ++i) {
+            std::copy(&input[i * width], &input[i * width] + width,
+                      &padded[static_cast<size_t>(i + pad_y) * pw + pad_x]);
+        }
+
+        // brute force over the short segment
+        #pragma omp for schedule(static)
+        for (int y = 0; y < ph; ++y) {
+            for (int x = 0; x < pw; ++x) {
+                unsigned char best = Op::identity;
+                for (size_t s = 0; s < d.seg_x.size(); ++s) {
+                    const int nx = x + sign * d.seg_x[s];
+                    const int ny = y + sign * d.seg_y[s];
+                    if (nx >= 0 && nx < pw && ny >= 0 && ny < ph) best = op(best, padded[ny * pw + nx]);
+                }
+                segment[static_cast<size_t>(y) * pw + x] = best;
+            }
+        }
+
+        // van Herk along the periodic lines, one row of starts at a time
+        #pragma omp for schedule(dynamic, 4)
+        for (int y = 0; y < ph; ++y) {
+            const bool whole_row = y >= band_y0 && y < band_y1;
+            const int x0 = whole_row ? 0 : band_x0;
+            const int x1 = whole_row ? pw : band_x1;
+            for (int x = x0; x < x1; ++x) {
+                const size_t start = static_cast<size_t>(y) * pw + x;
+                vanherk_1d<Op>(&segment[start], stride, &filtered[start], stride, line_length(x, y), m, scratch);
+            }
+        }
+    }
+
+    output.resize(width * height);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < height; ++i) {
+        const unsigned char* src = &filtered[static_cast<size_t>(i + pad_y) * pw + pad_x];
+        std::copy(src, src + width, &output[i * width]);
+    }
+}
+
+void line_erode(const std::vector<unsigned char>& input, std::vector<unsigned char>& output,
+                const int width, const int height, const LineDecomposition& d) {
+    line_stage<MinOp>(input, output, width, height, d, false);
+}
+
+void line_dilate(const std::vector<unsigned char>& input, std::vector<unsigned char>& output,
+                 const int width, const int height, const LineDecomposition& d) {
+    line_stage<MaxOp>(input, output, width, height, d, true);
+}
+
+void line_opening(const std::vector<unsigned char>& input, std::vector<unsigned char>& output,
+                  const int width, const int height, const LineDecomposition& d) {
+    std::vector<unsigned char> temp;
+    line_erode(input, temp, width, height, d);
+    line_dilate(temp, output, width, height, d);
+}
+
+} // namespace
+
+void Erode_Line_Parallel(const std::vector<unsigned char>& input,
+                         std::vector<unsigned char>& output,
+                         const int width, const int height,
+                         const int length, const double angle_deg) {
+
+    line_erode(input, output, width, height, make_decomposition(length, angle_deg));
+}
+
+void Dilate_Line_Parallel(const std::vector<unsigned char>& input,
+                          std::vector<unsigned char>& output,
+                          const int width, const int height,
+                          const int length, const double angle_deg) {
+
+    line_dilate(input, output, width, height, make_decomposition(length, angle_deg));
+}
+
+void Opening_Line_Parallel(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height,
+                           const int length, const double angle_deg) {
+
+    line_opening(input, output, width, height, make_decomposition(length, angle_deg));
+}
+
+// Orientations run one after another (each stage is parallel inside) and
+// are max-merged into the output, so only one opening image is alive.
+void Opening_LineBank_Parallel(const std::vector<unsigned char>& input,
+                               std::vector<unsigned char>& output,
+                               const int width, const int height,
+                               const int length, const int num_orientations) {
+
+    output.assign(width * height, 0);
+    if (num_orientations <= 0) return;
+
+    std::vector<unsigned char> opened;
+    for (int o = 0; o < num_orientations; ++o) {
+        line_opening(input, opened, width, height,
+                     make_decomposition(length, 180.0 * o / num_orientations));
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < width * height; ++i) {
+            output[i] = std::max(output[i], opened[i]);
+        }
+    }
+}
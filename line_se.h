@@ -0,0 +1,46 @@
+#ifndef LINE_SE_H
+#define LINE_SE_H
+
+#include <vector>
+
+// --- ELEMENTOS ESTRUCTURANTES LINEALES (ángulo arbitrario) ---
+//
+// The SE is a discrete line along a rational slope, so angles and lengths
+// are quantised; callers do not get exactly the line they ask for:
+// - the direction is the slope minor / period (period <= 8 pixels along the
+//   dominant axis) closest to `angle_deg` among the periods the length
+//   allows, e.g. 30 degrees becomes atan(4 / 7) = 29.7 degrees for length 21
+//   but atan(3 / 5) = 31.0 degrees for length 15; angles are
+//   counterclockwise from the horizontal;
+// - the length along the dominant axis is an odd number of periods and is
+//   within max(1, length / 5) pixels of `length`; slopes whose period cannot
+//   meet that are not used, falling back to shorter periods (coarser angles).
+// Following Soille & Talbot, the line is decomposed as a short Bresenham
+// segment (one period) dilated by a periodic line: the segment part is
+// brute force and the periodic part runs the van Herk recurrence along the
+// period vector, so cost per pixel does not depend on `length` and the SE
+// is the same at every pixel (translation invariant). Windows are clipped at
+// the image border.
+
+void Erode_Line_Parallel(const std::vector<unsigned char>& input,
+                         std::vector<unsigned char>& output,
+                         const int width, const int height,
+                         const int length, const double angle_deg);
+
+void Dilate_Line_Parallel(const std::vector<unsigned char>& input,
+                          std::vector<unsigned char>& output,
+                          const int width, const int height,
+                          const int length, const double angle_deg);
+
+void Opening_Line_Parallel(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height,
+                           const int length, const double angle_deg);
+
+// Supremum of line openings at angles k * 180 / num_orientations
+void Opening_LineBank_Parallel(const std::vector<unsigned char>& input,
+                               std::vector<unsigned char>& output,
+                               const int width, const int height,
+                               const int length, const int num_orientations);
+
+#endif // LINE_SE_H
@@ -14,32 +14,59 @@
 
 #include "sequential.h"
 #include "parallel.h"
+#include "batch.h"
+#include "pool_parallel.h"
+#include "thread_pool.h"
+#include "numa.h"
+#include "image_utils.h"
+#include "pipeline.h"
+#include "fused.h"
+#include "autotune.h"
+#include "sharded.h"
 
 namespace fs = std::filesystem;
 
 const int GRAYSCALE_CHANNELS = 1;
 
-// RGB to grayscale conversion
-std::vector<unsigned char> convert_to_grayscale(unsigned char* data, int width, int height, int n_channels) {
-    std::vector<unsigned char> grayscale_data;
-    grayscale_data.reserve(width * height);
-
-    for (int i = 0; i < width * height; ++i) {
-        if (n_channels >= 3) {
-            unsigned char r = data[i * n_channels];
-            unsigned char g = data[i * n_channels + 1];
-            unsigned char b = data[i * n_channels + 2];
-            unsigned char gray = static_cast<unsigned char>(std::round(0.299f * r + 0.587f * g + 0.114f * b));
-            grayscale_data.push_back(gray);
-        } else if (n_channels == 1) {
-            grayscale_data.push_back(data[i]);
+// Parallel opening implementation benchmarked against the sequential baseline
+using OpeningFunction = void (*)(const std::vector<unsigned char>&, std::vector<unsigned char>&,
+                                 const int, const int, const int);
+
+struct Backend {
+    std::string name;
+    OpeningFunction opening;
+};
+
+// Decodes up to max_images (-1 = all) .jpg/.png files of a folder to grayscale
+std::vector<GrayImage> load_gray_images(const fs::path& input_dir, int max_images) {
+    std::vector<GrayImage> images;
+
+    for (const auto& entry : fs::directory_iterator(input_dir)) {
+        if (max_images != -1 && static_cast<int>(images.size()) >= max_images) break;
+
+        if (entry.is_regular_file() &&
+            (entry.path().extension() == ".jpg" || entry.path().extension() == ".png")) {
+
+            std::string input_path = entry.path().string();
+            int width, height, channels;
+            unsigned char* image_data = stbi_load(input_path.c_str(), &width, &height, &channels, 0);
+            if (!image_data) continue;
+
+            GrayImage image;
+            image.pixels = convert_to_grayscale(image_data, width, height, channels);
+            image.width = width;
+            image.height = height;
+            stbi_image_free(image_data);
+
+            images.push_back(std::move(image));
         }
     }
-    return grayscale_data;
+    return images;
 }
 
 void run_performance_test(const std::string& input_folder, const std::string& output_folder,
-                          const std::string& csv_filename, int max_images, int kernel_size) {
+                          const std::string& csv_filename, int max_images, int kernel_size,
+                          bool pin_threads) {
 
     const fs::path project_root = "C:\\Users\\Lenovo\\Desktop\\UNIFI\\Parallel\\ProjectMidTermDefinitiu";
     const fs::path input_dir = project_root / input_folder;
@@ -48,6 +75,16 @@ void run_performance_test(const std::string& input_folder, const std::string& ou
     // Thread counts to test
     std::vector<int> thread_counts = {1, 2, 4, 8};
 
+    // Parallel backends to test (one CSV row per backend and thread count)
+    std::vector<Backend> backends = {
+        {"openmp", Opening_Parallel},
+        {"tiled", Opening_Parallel_Tiled},
+        {"threadpool", Opening_Pool},
+        {"openmp_numa", Opening_Parallel_Numa},
+        {"openmp_fused", Opening_Parallel_Fused},
+        {"auto", Opening_Auto},
+    };
+
     // make sure directories exist
     try {
         if (!fs::exists(output_dir)) {
@@ -68,7 +105,7 @@ void run_performance_test(const std::string& input_folder, const std::string& ou
 
     // Open CSV file for results
     std::ofstream csv_file(csv_filename);
-    csv_file << "Threads,Sequential_Time_ms,Parallel_Time_ms,Speedup,Efficiency" << std::endl;
+    csv_file << "Backend,Threads,Sequential_Time_ms,Parallel_Time_ms,Speedup,Efficiency" << std::endl;
 
     // Get sequential baseline first
     std::cout << "\nCalculating sequential baseline..." << std::endl;
@@ -101,59 +138,276 @@ void run_performance_test(const std::string& input_folder, const std::string& ou
 
     std::cout << "Sequential baseline: " << seq_baseline * 1000.0 << " ms (" << count << " images)" << std::endl;
 
-    // Test each thread count
+    // Test each backend and thread count
+    for (const Backend& backend : backends) {
+        for (int num_threads : thread_counts) {
+            omp_set_num_threads(num_threads);
+            Set_Thread_Pool_Size(num_threads);
+            // only the NUMA backend runs with pinned threads
+            if (pin_threads) Pin_Threads_Numa(backend.name == "openmp_numa");
+
+            std::cout << "\nTesting " << backend.name << " with " << num_threads << " thread(s)..." << std::endl;
+
+            double total_par_time = 0.0;
+            double total_copy_time = 0.0;  // openmp_numa: copy of the NUMA output into result_par
+            int img_count = 0;
+
+            for (const auto& entry : fs::directory_iterator(input_dir)) {
+                if (max_images != -1 && img_count >= max_images) break;
+
+                if (entry.is_regular_file() &&
+                    (entry.path().extension() == ".jpg" || entry.path().extension() == ".png")) {
+
+                    std::string input_path = entry.path().string();
+                    std::string filename = entry.path().filename().string();
+                    int width, height, channels;
+                    unsigned char* image_data = stbi_load(input_path.c_str(), &width, &height, &channels, 0);
+                    if (!image_data) continue;
+
+                    std::vector<unsigned char> gray_image = convert_to_grayscale(image_data, width, height, channels);
+                    stbi_image_free(image_data);
+
+                    // tune outside the timed region (no-op once the bucket is cached)
+                    if (backend.name == "auto") Autotune_Opening(width, height, kernel_size);
+
+                    std::vector<unsigned char> result_par;
+                    if (backend.name == "openmp_numa") {
+                        // input placed by the kernels' row partition (untimed); the output
+                        // is first-touched in parallel inside the timed call
+                        NumaImage numa_input, numa_output;
+                        Copy_To_Numa_Parallel(gray_image, numa_input, width, height);
+
+                        double start = omp_get_wtime();
+                        Opening_Parallel_Numa(numa_input, numa_output, width, height, kernel_size);
+                        double end = omp_get_wtime();
+                        total_par_time += (end - start);
+
+                        double copy_start = omp_get_wtime();
+                        result_par.assign(numa_output.begin(), numa_output.end());
+                        total_copy_time += omp_get_wtime() - copy_start;
+                    } else {
+                        double start = omp_get_wtime();
+                        backend.opening(gray_image, result_par, width, height, kernel_size);
+                        double end = omp_get_wtime();
+                        total_par_time += (end - start);
+                    }
+
+                    // Save output image for each thread count
+                    std::string name_without_ext = entry.path().stem().string();
+                    std::string extension = entry.path().extension().string();
+                    std::string backend_suffix = (backend.name == "openmp") ? "" : "_" + backend.name;
+                    std::string output_filename = name_without_ext + "_" + std::to_string(num_threads) + "threads" +
+                                                  backend_suffix + extension;
+                    std::string output_path = (output_dir / output_filename).string();
+                    stbi_write_png(output_path.c_str(), width, height, GRAYSCALE_CHANNELS,
+                                  result_par.data(), width * GRAYSCALE_CHANNELS);
+
+                    img_count++;
+                }
+            }
+
+            double speedup = seq_baseline / total_par_time;
+            double efficiency = speedup / num_threads;
+
+            std::cout << "  Parallel time: " << total_par_time * 1000.0 << " ms" << std::endl;
+            if (backend.name == "openmp_numa") {
+                std::cout << "  Copy-out time (not included): " << total_copy_time * 1000.0 << " ms" << std::endl;
+            }
+            std::cout << "  Speedup: " << speedup << "x" << std::endl;
+            std::cout << "  Efficiency: " << efficiency * 100.0 << "%" << std::endl;
+
+            // Write to CSV
+            csv_file << backend.name << ","
+                     << num_threads << ","
+                     << seq_baseline * 1000.0 << ","
+                     << total_par_time * 1000.0 << ","
+                     << speedup << ","
+                     << efficiency << std::endl;
+        }
+    }
+
+    csv_file.close();
+    std::cout << "\nResults saved to " << csv_filename << std::endl;
+}
+
+// Inter-image (one whole image per thread), intra-image (Opening_Parallel
+// per image) and hybrid throughput; images are decoded up front and not timed
+void run_throughput_test(const std::string& input_folder, const std::string& csv_filename,
+                         int max_images, int kernel_size) {
+
+    const fs::path project_root = "C:\\Users\\Lenovo\\Desktop\\UNIFI\\Parallel\\ProjectMidTermDefinitiu";
+    const fs::path input_dir = project_root / input_folder;
+
+    std::vector<int> thread_counts = {1, 2, 4, 8};
+
+    if (!fs::exists(input_dir)) {
+        std::cerr << "Error: input directory not found: " << input_dir << std::endl;
+        return;
+    }
+
+    std::vector<GrayImage> images = load_gray_images(input_dir, max_images);
+
+    std::cout << "\n=== Throughput " << input_folder << " (" << images.size() << " images) ===" << std::endl;
+
+    std::ofstream csv_file(csv_filename);
+    csv_file << "Mode,Threads,Images,Wall_Time_ms,Images_per_s" << std::endl;
+
+    // reference results, to check the hybrid scheduler once per thread count
+    std::vector<std::vector<unsigned char>> expected(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        Opening_Sequential(images[i].pixels, expected[i], images[i].width, images[i].height, kernel_size);
+    }
+
     for (int num_threads : thread_counts) {
         omp_set_num_threads(num_threads);
 
-        std::cout << "\nTesting with " << num_threads << " thread(s)..." << std::endl;
+        std::vector<std::vector<unsigned char>> results;
+        BatchTiming intra = Opening_Batch_Intra(images, results, kernel_size);
+        BatchTiming intra_separable = Opening_Batch_Intra_Separable(images, results, kernel_size);
+        BatchTiming inter = Opening_Batch_Throughput(images, results, kernel_size);
+        BatchTiming hybrid = Opening_Batch_Hybrid(images, results, kernel_size);
+        if (results != expected) {
+            std::cerr << "  Error: hybrid results differ from Opening_Sequential with "
+                      << num_threads << " thread(s)" << std::endl;
+        }
 
-        double total_par_time = 0.0;
-        int img_count = 0;
+        // intra_separable and inter run the same kernel, so their gap is scheduling only
+        std::cout << "  " << num_threads << " thread(s): intra " << intra.wall_time * 1000.0 << " ms ("
+                  << intra.images_per_second() << " img/s), intra_separable " << intra_separable.wall_time * 1000.0 << " ms ("
+                  << intra_separable.images_per_second() << " img/s), inter " << inter.wall_time * 1000.0 << " ms ("
+                  << inter.images_per_second() << " img/s), hybrid " << hybrid.wall_time * 1000.0 << " ms ("
+                  << hybrid.images_per_second() << " img/s)" << std::endl;
+
+        csv_file << "intra," << num_threads << "," << intra.images << ","
+                 << intra.wall_time * 1000.0 << "," << intra.images_per_second() << std::endl;
+        csv_file << "intra_separable," << num_threads << "," << intra_separable.images << ","
+                 << intra_separable.wall_time * 1000.0 << "," << intra_separable.images_per_second() << std::endl;
+        csv_file << "inter," << num_threads << "," << inter.images << ","
+                 << inter.wall_time * 1000.0 << "," << inter.images_per_second() << std::endl;
+        csv_file << "hybrid," << num_threads << "," << hybrid.images << ","
+                 << hybrid.wall_time * 1000.0 << "," << hybrid.images_per_second() << std::endl;
+    }
 
-        for (const auto& entry : fs::directory_iterator(input_dir)) {
-            if (max_images != -1 && img_count >= max_images) break;
+    csv_file.close();
+    std::cout << "Results saved to " << csv_filename << std::endl;
+}
 
-            if (entry.is_regular_file() &&
-                (entry.path().extension() == ".jpg" || entry.path().extension() == ".png")) {
 
-                std::string input_path = entry.path().string();
-                std::string filename = entry.path().filename().string();
-                int width, height, channels;
-                unsigned char* image_data = stbi_load(input_path.c_str(), &width, &height, &channels, 0);
-                if (!image_data) continue;
+// Overlapped decode -> convert -> opening -> encode over a folder, with
+// per-stage utilization to balance the stage thread counts
+void run_pipeline_test(const std::string& input_folder, const std::string& output_folder,
+                       const std::string& csv_filename, int max_images, int kernel_size) {
 
-                std::vector<unsigned char> gray_image = convert_to_grayscale(image_data, width, height, channels);
-                stbi_image_free(image_data);
+    const fs::path project_root = "C:\\Users\\Lenovo\\Desktop\\UNIFI\\Parallel\\ProjectMidTermDefinitiu";
+    const fs::path input_dir = project_root / input_folder;
+    const fs::path output_dir = project_root / output_folder;
 
-                std::vector<unsigned char> result_par;
-                double start = omp_get_wtime();
-                Opening_Parallel(gray_image, result_par, width, height, kernel_size);
-                double end = omp_get_wtime();
-                total_par_time += (end - start);
+    if (!fs::exists(input_dir)) {
+        std::cerr << "Error: input directory not found: " << input_dir << std::endl;
+        return;
+    }
+    fs::create_directories(output_dir);
 
-                // Save output image for each thread count
-                std::string name_without_ext = entry.path().stem().string();
-                std::string extension = entry.path().extension().string();
-                std::string output_filename = name_without_ext + "_" + std::to_string(num_threads) + "threads" + extension;
-                std::string output_path = (output_dir / output_filename).string();
-                stbi_write_png(output_path.c_str(), width, height, GRAYSCALE_CHANNELS,
-                              result_par.data(), width * GRAYSCALE_CHANNELS);
+    std::vector<std::string> input_paths, output_paths;
+    for (const auto& entry : fs::directory_iterator(input_dir)) {
+        if (max_images != -1 && static_cast<int>(input_paths.size()) >= max_images) break;
 
-                img_count++;
-            }
+        if (entry.is_regular_file() &&
+            (entry.path().extension() == ".jpg" || entry.path().extension() == ".png")) {
+            input_paths.push_back(entry.path().string());
+            output_paths.push_back((output_dir / (entry.path().stem().string() + "_pipeline.png")).string());
+        }
+    }
+
+    PipelineConfig config;
+    PipelineStats stats = Opening_Pipeline(input_paths, output_paths, kernel_size, config);
+
+    std::cout << "\n=== Pipeline " << input_folder << " (" << stats.images << " images) ===" << std::endl;
+    std::cout << "  Wall time: " << stats.wall_time * 1000.0 << " ms ("
+              << (stats.wall_time > 0.0 ? stats.images / stats.wall_time : 0.0) << " img/s)" << std::endl;
+
+    std::ofstream csv_file(csv_filename);
+    csv_file << "Stage,Threads,Images,Busy_Time_ms,Utilization" << std::endl;
+
+    for (const StageStats& stage : stats.stages) {
+        const double utilization = stage.utilization(stats.wall_time);
+        std::cout << "  " << stage.name << ": " << stage.threads << " thread(s), busy "
+                  << stage.busy_time * 1000.0 << " ms, utilization " << utilization * 100.0 << "%" << std::endl;
+        csv_file << stage.name << "," << stage.threads << "," << stage.images << ","
+                 << stage.busy_time * 1000.0 << "," << utilization << std::endl;
+    }
+    csv_file << "wall,,"  << stats.images << "," << stats.wall_time * 1000.0 << "," << std::endl;
+
+    csv_file.close();
+}
+
+// Forked worker processes sharing a queue in POSIX shared memory; one CSV
+// row per process count in the performance_results format
+void run_sharded_test(const std::string& input_folder, const std::string& output_folder,
+                      const std::string& csv_filename, int max_images, int kernel_size) {
+
+    const fs::path project_root = "C:\\Users\\Lenovo\\Desktop\\UNIFI\\Parallel\\ProjectMidTermDefinitiu";
+    const fs::path input_dir = project_root / input_folder;
+    const fs::path output_dir = project_root / output_folder;
+
+    std::vector<int> process_counts = {1, 2, 4, 8};
+
+    if (!fs::exists(input_dir)) {
+        std::cerr << "Error: input directory not found: " << input_dir << std::endl;
+        return;
+    }
+    fs::create_directories(output_dir);
+
+    std::vector<std::string> input_paths;
+    std::vector<fs::path> entries;
+    for (const auto& entry : fs::directory_iterator(input_dir)) {
+        if (max_images != -1 && static_cast<int>(input_paths.size()) >= max_images) break;
+
+        if (entry.is_regular_file() &&
+            (entry.path().extension() == ".jpg" || entry.path().extension() == ".png")) {
+            input_paths.push_back(entry.path().string());
+            entries.push_back(entry.path());
+        }
+    }
+
+    std::cout << "\n=== Sharded processes " << input_folder << " (" << input_paths.size() << " images) ===" << std::endl;
+
+    std::ofstream csv_file(csv_filename);
+    csv_file << "Backend,Threads,Sequential_Time_ms,Parallel_Time_ms,Speedup,Efficiency" << std::endl;
+
+    // the single-process run is the sequential baseline
+    double seq_baseline = 0.0;
+
+    for (int num_processes : process_counts) {
+        std::vector<std::string> output_paths;
+        for (const fs::path& path : entries) {
+            output_paths.push_back((output_dir / (path.stem().string() + "_" + std::to_string(num_processes) +
+                                                  "processes.png")).string());
+        }
+
+        std::cout << "\nTesting processes with " << num_processes << " process(es)..." << std::endl;
+
+        ShardedResult result;
+        if (!Opening_Sharded(input_paths, output_paths, kernel_size, num_processes, result, true)) {
+            std::cerr << "Error: sharded run failed (needs POSIX fork and shared memory)" << std::endl;
+            return;
         }
 
-        double speedup = seq_baseline / total_par_time;
-        double efficiency = speedup / num_threads;
+        // filtering critical path, comparable to the other backends' times
+        double par_time = result.max_busy_time();
+        if (num_processes == 1) seq_baseline = par_time;
 
-        std::cout << "  Parallel time: " << total_par_time * 1000.0 << " ms" << std::endl;
+        double speedup = par_time > 0.0 ? seq_baseline / par_time : 0.0;
+        double efficiency = speedup / num_processes;
+
+        std::cout << "  Parallel time: " << par_time * 1000.0 << " ms (wall " << result.wall_time * 1000.0
+                  << " ms with I/O)" << std::endl;
         std::cout << "  Speedup: " << speedup << "x" << std::endl;
         std::cout << "  Efficiency: " << efficiency * 100.0 << "%" << std::endl;
 
-        // Write to CSV
-        csv_file << num_threads << ","
+        csv_file << "processes," << num_processes << ","
                  << seq_baseline * 1000.0 << ","
-                 << total_par_time * 1000.0 << ","
+                 << par_time * 1000.0 << ","
                  << speedup << ","
                  << efficiency << std::endl;
     }
@@ -162,7 +416,6 @@ void run_performance_test(const std::string& input_folder, const std::string& ou
     std::cout << "\nResults saved to " << csv_filename << std::endl;
 }
 
-
 int main(int argc, char* argv[]) {
 
     const int kernel_size = 9;
@@ -176,19 +429,39 @@ int main(int argc, char* argv[]) {
     if (argc > 2) {
         max_images2 = std::stoi(argv[2]);
     }
+    bool pin_threads = false;
+    if (argc > 3) {
+        pin_threads = std::stoi(argv[3]) != 0;
+    }
 
     std::cout << "=== Thread Performance Test ===" << std::endl;
     std::cout << "Test 1: input_images (max: " << (max_images1 == -1 ? "all" : std::to_string(max_images1)) << ")" << std::endl;
     std::cout << "Test 2: input_images2 (max: " << (max_images2 == -1 ? "all" : std::to_string(max_images2)) << ")" << std::endl;
+    std::cout << "NUMA thread pinning: " << (pin_threads ? "on" : "off") << std::endl;
 
     // Run test 1
-    run_performance_test("input_images", "output_images", "performance_results_1.csv", max_images1, kernel_size);
+    run_performance_test("input_images", "output_images", "performance_results_1.csv", max_images1, kernel_size, pin_threads);
 
     // Run test 2
-    run_performance_test("input_images2", "output_images2", "performance_results_2.csv", max_images2, kernel_size);
+    run_performance_test("input_images2", "output_images2", "performance_results_2.csv", max_images2, kernel_size, pin_threads);
+
+    // Throughput (images/s) for both folders
+    run_throughput_test("input_images", "throughput_results_1.csv", max_images1, kernel_size);
+    run_throughput_test("input_images2", "throughput_results_2.csv", max_images2, kernel_size);
+
+    // Overlapped load/filter/save
+    run_pipeline_test("input_images", "output_images", "pipeline_results_1.csv", max_images1, kernel_size);
+    run_pipeline_test("input_images2", "output_images2", "pipeline_results_2.csv", max_images2, kernel_size);
+
+    // Multi-process batch runner
+    run_sharded_test("input_images", "output_images", "sharded_results_1.csv", max_images1, kernel_size);
+    run_sharded_test("input_images2", "output_images2", "sharded_results_2.csv", max_images2, kernel_size);
 
     std::cout << "\n=== All tests completed ===" << std::endl;
     std::cout << "Results saved to performance_results_1.csv and performance_results_2.csv" << std::endl;
+    std::cout << "Throughput saved to throughput_results_1.csv and throughput_results_2.csv" << std::endl;
+    std::cout << "Pipeline stages saved to pipeline_results_1.csv and pipeline_results_2.csv" << std::endl;
+    std::cout << "Process runs saved to sharded_results_1.csv and sharded_results_2.csv" << std::endl;
 
     return 0;
 }
@@ -0,0 +1,85 @@
+#ifndef MORPH_1D_H
+#define MORPH_1D_H
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// --- FILTROS 1D MIN/MAX (van Herk / Gil-Werman) ---
+//
+// Window [i - radius, i + radius] clipped to [0, n), the same border rule as
+// the 2D kernels in sequential.cpp / parallel.cpp. Cost is 3 comparisons per
+// sample regardless of radius. Input and output may be strided so the same
+// routine filters rows, columns and discrete lines.
+
+struct MinOp {
+    static constexpr unsigned char identity = 255;
+    unsigned char operator()(unsigned char a, unsigned char b) const { return a < b ? a : b; }
+};
+
+struct MaxOp {
+    static constexpr unsigned char identity = 0;
+    unsigned char operator()(unsigned char a, unsigned char b) const { return a > b ? a : b; }
+};
+
+// Scratch buffers reused between calls (one set per thread)
+struct VanHerkScratch {
+    std::vector<unsigned char> padded;
+    std::vector<unsigned char> prefix;
+    std::vector<unsigned char> suffix;
+};
+
+template <typename Op>
+inline void vanherk_1d(const unsigned char* input, const int in_stride,
+                       unsigned char* output, const int out_stride,
+                       const int n, const int radius, VanHerkScratch& scratch) {
+    const Op op;
+
+    if (radius <= 0) {
+        for (int i = 0; i < n; ++i) output[static_cast<std::ptrdiff_t>(i) * out_stride] = input[static_cast<std::ptrdiff_t>(i) * in_stride];
+        return;
+    }
+
+    const int window = 2 * radius + 1;
+    const int padded_len = n + 2 * radius;
+
+    if (static_cast<int>(scratch.padded.size()) < padded_len) {
+        scratch.padded.resize(padded_len);
+        scratch.prefix.resize(padded_len);
+        scratch.suffix.resize(padded_len);
+    }
+    unsigned char* p = scratch.padded.data();
+    unsigned char* g = scratch.prefix.data();
+    unsigned char* h = scratch.suffix.data();
+
+    std::fill(p, p + radius, Op::identity);
+    for (int i = 0; i < n; ++i) p[radius + i] = input[static_cast<std::ptrdiff_t>(i) * in_stride];
+    std::fill(p + radius + n, p + padded_len, Op::identity);
+
+    // prefix / suffix extrema inside blocks of size `window`
+    for (int b = 0; b < padded_len; b += window) {
+        const int e = std::min(b + window, padded_len);
+        g[b] = p[b];
+        for (int x = b + 1; x < e; ++x) g[x] = op(g[x - 1], p[x]);
+        h[e - 1] = p[e - 1];
+        for (int x = e - 2; x >= b; --x) h[x] = op(h[x + 1], p[x]);
+    }
+
+    for (int i = 0; i < n; ++i) {
+        output[static_cast<std::ptrdiff_t>(i) * out_stride] = op(h[i], g[i + window - 1]);
+    }
+}
+
+inline void erode_1d(const unsigned char* input, const int in_stride,
+                     unsigned char* output, const int out_stride,
+                     const int n, const int radius, VanHerkScratch& scratch) {
+    vanherk_1d<MinOp>(input, in_stride, output, out_stride, n, radius, scratch);
+}
+
+inline void dilate_1d(const unsigned char* input, const int in_stride,
+                      unsigned char* output, const int out_stride,
+                      const int n, const int radius, VanHerkScratch& scratch) {
+    vanherk_1d<MaxOp>(input, in_stride, output, out_stride, n, radius, scratch);
+}
+
+#endif // MORPH_1D_H
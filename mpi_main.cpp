@@ -0,0 +1,301 @@
+// Distributed opening over MPI: the image is split into horizontal strips,
+// one per rank, and OpenMP runs inside each rank. Each rank holds only its
+// strip plus kernel_radius halo rows; between erosion and dilation the
+// eroded halo rows are swapped with the neighbours.
+//
+//   mpirun -np 4 ./mpi_main.exe [--synthetic W H | --raw path W H | --image path]
+//                               [--kernel K] [--output result.raw] [--check]
+//
+// --synthetic (default 2000x1500): every rank generates its own rows.
+// --raw: 8-bit grayscale, row-major file; every rank reads its own rows.
+// --image: .png/.jpg decoded on rank 0 (stb cannot decode part of a file),
+//          which sends each rank its rows; use --raw for images beyond one node.
+// --output: the result is written as raw 8-bit with MPI-IO, each rank its rows.
+// --check: gathers the result on rank 0 and compares it with
+//          Opening_Sequential over the whole image (small images only).
+//
+// Strips of large slides exceed INT_MAX pixels, so every transfer and write
+// counts whole rows of a contiguous row datatype, and byte sizes and
+// offsets are computed in 64 bits.
+#include <mpi.h>
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "libs/stb_image.h"
+
+#include "sequential.h"
+#include "roi.h"
+#include "image_utils.h"
+
+enum class Source { Synthetic, Raw, Image };
+
+struct Options {
+    Source source = Source::Synthetic;
+    std::string path;
+    int width = 2000;
+    int height = 1500;
+    int kernel_size = 9;
+    std::string output;
+    bool check = false;
+};
+
+bool parse_options(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        try {
+            if (arg == "--synthetic" && i + 2 < argc) {
+                options.source = Source::Synthetic;
+                options.width = std::stoi(argv[++i]);
+                options.height = std::stoi(argv[++i]);
+            } else if (arg == "--raw" && i + 3 < argc) {
+                options.source = Source::Raw;
+                options.path = argv[++i];
+                options.width = std::stoi(argv[++i]);
+                options.height = std::stoi(argv[++i]);
+            } else if (arg == "--image" && i + 1 < argc) {
+                options.source = Source::Image;
+                options.path = argv[++i];
+            } else if (arg == "--kernel" && i + 1 < argc) {
+                options.kernel_size = std::stoi(argv[++i]);
+            } else if (arg == "--output" && i + 1 < argc) {
+                options.output = argv[++i];
+            } else if (arg == "--check") {
+                options.check = true;
+            } else {
+                return false;
+            }
+        } catch (...) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Deterministic pseudo-random pixel, so any rank can generate any row
+unsigned char synthetic_pixel(const int x, const int y) {
+    uint32_t h = static_cast<uint32_t>(x) * 0x9E3779B1u ^ static_cast<uint32_t>(y) * 0x85EBCA77u;
+    h ^= h >> 15;
+    h *= 0x2C1B3C6Du;
+    h ^= h >> 12;
+    return static_cast<unsigned char>(h & 0xff);
+}
+
+// Fills `rows` rows of the image starting at `first_row` into `buffer`
+bool load_rows(const Options& options, const int first_row, const int rows,
+               unsigned char* buffer) {
+    const int width = options.width;
+    if (options.source == Source::Synthetic) {
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < rows; ++i) {
+            for (int j = 0; j < width; ++j) buffer[static_cast<size_t>(i) * width + j] = synthetic_pixel(j, first_row + i);
+        }
+        return true;
+    }
+
+    std::ifstream file(options.path, std::ios::binary);
+    if (!file) return false;
+    file.seekg(static_cast<std::streamoff>(first_row) * width);
+    file.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(rows) * width);
+    return static_cast<bool>(file);
+}
+
+// First row of the strip of `rank` (strip r is [strip_begin(r), strip_begin(r + 1)))
+int strip_begin(const int rank, const int num_ranks, const int height) {
+    return static_cast<int>(static_cast<long long>(height) * rank / num_ranks);
+}
+
+// `local` holds `top` halo rows, `rows` own rows, then `bottom` halo rows.
+// Own edge rows go to the neighbours and their edge rows fill the halos.
+void exchange_halos(std::vector<unsigned char>& local, const int width, const int rows,
+                    const int top, const int bottom, const int rank, const int num_ranks,
+                    MPI_Datatype row_type) {
+
+    const int up = rank > 0 ? rank - 1 : MPI_PROC_NULL;
+    const int down = rank < num_ranks - 1 ? rank + 1 : MPI_PROC_NULL;
+    unsigned char* own = local.data() + static_cast<size_t>(top) * width;
+
+    // first own rows up, bottom halo from below
+    MPI_Sendrecv(own, top, row_type, up, 0,
+                 own + static_cast<size_t>(rows) * width, bottom, row_type, down, 0,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+
+    // last own rows down, top halo from above
+    MPI_Sendrecv(own + static_cast<size_t>(rows - bottom) * width, bottom, row_type, down, 1,
+                 local.data(), top, row_type, up, 1,
+                 MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+
+    int rank, num_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+    Options options;
+    if (!parse_options(argc, argv, options)) {
+        if (rank == 0) {
+            std::cerr << "Usage: mpi_main.exe [--synthetic W H | --raw path W H | --image path]"
+                      << " [--kernel K] [--output result.raw] [--check]" << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+    const int kernel_size = options.kernel_size;
+    const int kernel_radius = kernel_size / 2;
+
+    // --image: rank 0 decodes the whole file
+    std::vector<unsigned char> decoded;
+    if (options.source == Source::Image) {
+        int size[2] = {0, 0};
+        if (rank == 0) {
+            int channels;
+            unsigned char* data = stbi_load(options.path.c_str(), &size[0], &size[1], &channels, 0);
+            if (data) {
+                decoded = convert_to_grayscale(data, size[0], size[1], channels);
+                stbi_image_free(data);
+            } else {
+                std::cerr << "Error: cannot load " << options.path << std::endl;
+            }
+        }
+        MPI_Bcast(size, 2, MPI_INT, 0, MPI_COMM_WORLD);
+        options.width = size[0];
+        options.height = size[1];
+    }
+
+    const int width = options.width;
+    const int height = options.height;
+    if (width <= 0 || height <= 0) {
+        MPI_Finalize();
+        return 1;
+    }
+
+    // every strip must cover a full halo for its neighbours
+    if (height / num_ranks < kernel_radius) {
+        if (rank == 0) {
+            std::cerr << "Error: " << num_ranks << " strips of " << height / num_ranks
+                      << " rows are thinner than the kernel radius " << kernel_radius << std::endl;
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    const int first_row = strip_begin(rank, num_ranks, height);
+    const int rows = strip_begin(rank + 1, num_ranks, height) - first_row;
+    const int top = rank > 0 ? kernel_radius : 0;
+    const int bottom = rank < num_ranks - 1 ? kernel_radius : 0;
+    const int local_height = top + rows + bottom;
+
+    // one image row; all MPI counts below are row counts
+    MPI_Datatype row_type;
+    MPI_Type_contiguous(width, MPI_UNSIGNED_CHAR, &row_type);
+    MPI_Type_commit(&row_type);
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+
+    // own rows plus input halos
+    std::vector<unsigned char> local(static_cast<size_t>(local_height) * width);
+    int load_ok = 1;
+    if (options.source == Source::Image) {
+        if (rank == 0) {
+            for (int r = 1; r < num_ranks; ++r) {
+                const int r_first = strip_begin(r, num_ranks, height) - kernel_radius;
+                const int r_last = std::min(height, strip_begin(r + 1, num_ranks, height) + kernel_radius);
+                MPI_Send(decoded.data() + static_cast<size_t>(r_first) * width, r_last - r_first,
+                         row_type, r, 2, MPI_COMM_WORLD);
+            }
+            std::copy(decoded.begin(), decoded.begin() + local.size(), local.begin());
+        } else {
+            MPI_Recv(local.data(), local_height, row_type, 0, 2,
+                     MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        }
+    } else {
+        load_ok = load_rows(options, first_row - top, local_height, local.data()) ? 1 : 0;
+    }
+
+    int all_ok = 0;
+    MPI_Allreduce(&load_ok, &all_ok, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    if (!all_ok) {
+        if (rank == 0) std::cerr << "Error: cannot read " << options.path << std::endl;
+        MPI_Type_free(&row_type);
+        MPI_Finalize();
+        return 1;
+    }
+
+    // erosion of the own rows; the halos make the windows complete
+    const Rect own_rows{0, top, width, rows};
+    std::vector<unsigned char> eroded_strip;
+    Erode_ROI_Parallel(local, eroded_strip, width, local_height, kernel_size, own_rows);
+
+    // halos of the eroded image, then dilation
+    std::copy(eroded_strip.begin(), eroded_strip.end(), local.begin() + static_cast<size_t>(top) * width);
+    exchange_halos(local, width, rows, top, bottom, rank, num_ranks, row_type);
+
+    std::vector<unsigned char> opened_strip;
+    Dilate_ROI_Parallel(local, opened_strip, width, local_height, kernel_size, own_rows);
+
+    double elapsed = MPI_Wtime() - start;
+    double max_elapsed = 0.0;
+    MPI_Reduce(&elapsed, &max_elapsed, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (!options.output.empty()) {
+        MPI_File file;
+        MPI_File_open(MPI_COMM_WORLD, options.output.c_str(), MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                      MPI_INFO_NULL, &file);
+        MPI_File_set_size(file, static_cast<MPI_Offset>(width) * height);
+        MPI_File_write_at_all(file, static_cast<MPI_Offset>(first_row) * width, opened_strip.data(),
+                              rows, row_type, MPI_STATUS_IGNORE);
+        MPI_File_close(&file);
+    }
+
+    if (rank == 0) {
+        std::cout << "=== MPI Opening ===" << std::endl;
+        std::cout << "Image: " << width << "x" << height << ", kernel " << kernel_size << "x" << kernel_size << std::endl;
+        std::cout << "Ranks: " << num_ranks << ", OpenMP threads per rank: " << omp_get_max_threads() << std::endl;
+        std::cout << "MPI time (slowest rank): " << max_elapsed * 1000.0 << " ms" << std::endl;
+    }
+
+    int status = 0;
+    if (options.check) {
+        std::vector<int> counts(num_ranks), displs(num_ranks);
+        for (int r = 0; r < num_ranks; ++r) {
+            displs[r] = strip_begin(r, num_ranks, height);
+            counts[r] = strip_begin(r + 1, num_ranks, height) - displs[r];
+        }
+
+        std::vector<unsigned char> result(rank == 0 ? static_cast<size_t>(width) * height : 0);
+        MPI_Gatherv(opened_strip.data(), rows, row_type,
+                    result.data(), counts.data(), displs.data(), row_type,
+                    0, MPI_COMM_WORLD);
+
+        if (rank == 0) {
+            std::vector<unsigned char> image = decoded;
+            if (options.source != Source::Image) {
+                image.resize(static_cast<size_t>(width) * height);
+                load_rows(options, 0, height, image.data());
+            }
+
+            std::vector<unsigned char> expected;
+            double seq_start = omp_get_wtime();
+            Opening_Sequential(image, expected, width, height, kernel_size);
+            double seq_time = omp_get_wtime() - seq_start;
+
+            const bool match = expected == result;
+            status = match ? 0 : 1;
+            std::cout << "Sequential time: " << seq_time * 1000.0 << " ms" << std::endl;
+            std::cout << "Check against Opening_Sequential: " << (match ? "OK" : "MISMATCH") << std::endl;
+        }
+        MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD);
+    }
+
+    MPI_Type_free(&row_type);
+    MPI_Finalize();
+    return status;
+}
@@ -0,0 +1,176 @@
+#include "numa.h"
+#include "morph_1d.h"
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <omp.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+void First_Touch_Parallel(NumaImage& image, const int width, const int height) {
+    image.resize(width * height);
+    unsigned char* data = image.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < height; ++i) {
+        std::memset(data + static_cast<size_t>(i) * width, 0, width);
+    }
+}
+
+void Copy_To_Numa_Parallel(const std::vector<unsigned char>& input, NumaImage& output,
+                           const int width, const int height) {
+    output.resize(width * height);
+    const unsigned char* src = input.data();
+    unsigned char* dst = output.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < height; ++i) {
+        std::memcpy(dst + static_cast<size_t>(i) * width, src + static_cast<size_t>(i) * width, width);
+    }
+}
+
+// Same window as Dilate_Parallel / Erode_Parallel, but rows are split with
+// schedule(static) so the partition matches First_Touch_Parallel. Op is a
+// stateless MinOp / MaxOp so the comparison inlines like in those kernels.
+template <typename Op>
+static void numa_filter(const unsigned char* input, unsigned char* output,
+                        const int width, const int height, const int kernel_size) {
+
+    const int kernel_radius = kernel_size / 2;
+    const Op op;
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < height; ++i) {
+        for (int j = 0; j < width; ++j) {
+            unsigned char best = Op::identity;
+
+            for (int u = -kernel_radius; u <= kernel_radius; ++u) {
+                for (int v = -kernel_radius; v <= kernel_radius; ++v) {
+                    int ni = i + u;
+                    int nj = j + v;
+
+                    if (ni >= 0 && ni < height && nj >= 0 && nj < width) {
+                        best = op(best, input[ni * width + nj]);
+                    }
+                }
+            }
+            output[i * width + j] = best;
+        }
+    }
+}
+
+void Dilate_Parallel_Numa(const NumaImage& input, NumaImage& output,
+                          const int width, const int height, const int kernel_size) {
+
+    if (static_cast<int>(output.size()) != width * height) First_Touch_Parallel(output, width, height);
+    numa_filter<MaxOp>(input.data(), output.data(), width, height, kernel_size);
+}
+
+void Erode_Parallel_Numa(const NumaImage& input, NumaImage& output,
+                         const int width, const int height, const int kernel_size) {
+
+    if (static_cast<int>(output.size()) != width * height) First_Touch_Parallel(output, width, height);
+    numa_filter<MinOp>(input.data(), output.data(), width, height, kernel_size);
+}
+
+void Opening_Parallel_Numa(const NumaImage& input, NumaImage& output,
+                           const int width, const int height, const int kernel_size) {
+
+    NumaImage temp;
+
+    Erode_Parallel_Numa(input, temp, width, height, kernel_size);
+    Dilate_Parallel_Numa(temp, output, width, height, kernel_size);
+}
+
+void Opening_Parallel_Numa(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height, const int kernel_size) {
+
+    NumaImage temp;
+    First_Touch_Parallel(temp, width, height);
+    output.resize(width * height);
+
+    numa_filter<MinOp>(input.data(), temp.data(), width, height, kernel_size);
+    numa_filter<MaxOp>(temp.data(), output.data(), width, height, kernel_size);
+}
+
+#ifdef __linux__
+
+// Parses a sysfs cpulist such as "0-3,8-11" into `cpus`
+static void parse_cpulist(const std::string& list, cpu_set_t& cpus) {
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+        const std::string item = list.substr(pos, end - pos);
+        const size_t dash = item.find('-');
+        try {
+            const int first = std::stoi(item.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+            for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; ++cpu) CPU_SET(cpu, &cpus);
+        } catch (...) {
+            // blank or malformed entry
+        }
+        pos = end + 1;
+    }
+}
+
+// CPU set of every node, in node order
+static std::vector<cpu_set_t> read_numa_nodes() {
+    std::vector<cpu_set_t> nodes;
+    for (int node = 0; ; ++node) {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        if (!file) break;
+        std::string list;
+        std::getline(file, list);
+
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        parse_cpulist(list, cpus);
+        if (CPU_COUNT(&cpus) > 0) nodes.push_back(cpus);
+    }
+    return nodes;
+}
+
+// Affinity of the calling thread before the first pinning; new OpenMP
+// threads inherit the master's mask, so one mask restores the whole team
+static bool threads_pinned = false;
+static cpu_set_t saved_affinity;
+
+int Pin_Threads_Numa(const bool enable) {
+    const std::vector<cpu_set_t> nodes = read_numa_nodes();
+    if (nodes.empty()) return 0;
+
+    const int num_nodes = static_cast<int>(nodes.size());
+
+    if (!enable) {
+        if (threads_pinned) {
+            #pragma omp parallel
+            sched_setaffinity(0, sizeof(cpu_set_t), &saved_affinity);
+            threads_pinned = false;
+        }
+        return num_nodes;
+    }
+
+    if (!threads_pinned) {
+        if (sched_getaffinity(0, sizeof(cpu_set_t), &saved_affinity) != 0) return 0;
+        threads_pinned = true;
+    }
+
+    #pragma omp parallel
+    {
+        const int t = omp_get_thread_num();
+        const int num_threads = omp_get_num_threads();
+        sched_setaffinity(0, sizeof(cpu_set_t), &nodes[static_cast<long long>(t) * num_nodes / num_threads]);
+    }
+    return num_nodes;
+}
+
+#else
+
+int Pin_Threads_Numa(const bool) {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// --- MEMORIA NUMA (first touch) Y AFINIDAD DE HILOS ---
+//
+// Linux places a page on the node of the thread that first writes it.
+// std::vector::resize zero-fills from the calling thread, so a whole output
+// image ends up on one socket. Buffers here are left untouched by the
+// allocator and first written in parallel with the same schedule(static)
+// row partition as the kernels, so each thread's rows stay on its node.
+
+// std::allocator that default-initializes: resize() does not write memory
+template <typename T>
+struct FirstTouchAllocator : std::allocator<T> {
+    template <typename U>
+    struct rebind { using other = FirstTouchAllocator<U>; };
+
+    FirstTouchAllocator() noexcept = default;
+    template <typename U>
+    FirstTouchAllocator(const FirstTouchAllocator<U>&) noexcept {}
+
+    template <typename U>
+    void construct(U* p) noexcept { ::new (static_cast<void*>(p)) U; }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) { ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...); }
+};
+
+using NumaImage = std::vector<unsigned char, FirstTouchAllocator<unsigned char>>;
+
+// Sizes `image` to width * height and zeroes it with the kernels' row partition
+void First_Touch_Parallel(NumaImage& image, const int width, const int height);
+
+// Copies an image into a NumaImage placed with the kernels' row partition
+void Copy_To_Numa_Parallel(const std::vector<unsigned char>& input, NumaImage& output,
+                           const int width, const int height);
+
+void Dilate_Parallel_Numa(const NumaImage& input, NumaImage& output,
+                          const int width, const int height, const int kernel_size);
+
+void Erode_Parallel_Numa(const NumaImage& input, NumaImage& output,
+                         const int width, const int height, const int kernel_size);
+
+void Opening_Parallel_Numa(const NumaImage& input, NumaImage& output,
+                           const int width, const int height, const int kernel_size);
+
+// parallel.h signature for callers holding std::vectors: only the
+// intermediate image is first-touched in parallel; a fresh `output` is still
+// zero-filled by the calling thread, so use the NumaImage overload when the
+// output placement matters
+void Opening_Parallel_Numa(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height, const int kernel_size);
+
+// Pins OpenMP thread t of T to the CPUs of node t * nodes / T (contiguous
+// threads, hence contiguous rows, share a node); topology is read from
+// /sys/devices/system/node. enable = false restores the affinity the
+// calling thread had before the first pinning, on every thread of the team.
+// Returns the number of nodes found, 0 where pinning is unsupported.
+int Pin_Threads_Numa(const bool enable);
+
+#endif // NUMA_H
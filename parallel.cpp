@@ -1,5 +1,17 @@
 #include "parallel.h"
+#include <algorithm>
+#include <cmath>
 #include <omp.h>
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+// Used when the L2 size cannot be queried
+static const long DEFAULT_L2_BYTES = 256 * 1024;
+// Tiles per thread the tiled backend aims for, so no thread sits idle
+static const int TILES_PER_THREAD = 4;
+// Tiles are never cut below this many rows or columns
+static const int MIN_TILE_SIDE = 8;
 
 // Parallel dilation using OpenMP
 void Dilate_Parallel(const std::vector<unsigned char>& input,
@@ -73,3 +85,178 @@ void Opening_Parallel(const std::vector<unsigned char>& input,
     Erode_Parallel(input, temp, width, height, kernel_size);
     Dilate_Parallel(temp, output, width, height, kernel_size);
 }
+
+// Gradient = dilation - erosion, both extrema from one pass over the window
+void Gradient_Parallel(const std::vector<unsigned char>& input,
+                       std::vector<unsigned char>& output,
+                       const int width, const int height, const int kernel_size) {
+
+    const int kernel_radius = kernel_size / 2;
+    output.resize(width * height);
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int i = 0; i < height; ++i) {
+        for (int j = 0; j < width; ++j) {
+            unsigned char min_val = 255;
+            unsigned char max_val = 0;
+
+            for (int u = -kernel_radius; u <= kernel_radius; ++u) {
+                for (int v = -kernel_radius; v <= kernel_radius; ++v) {
+                    int ni = i + u;
+                    int nj = j + v;
+
+                    if (ni >= 0 && ni < height && nj >= 0 && nj < width) {
+                        unsigned char current_pixel = input[ni * width + nj];
+                        if (current_pixel < min_val) {
+                            min_val = current_pixel;
+                        }
+                        if (current_pixel > max_val) {
+                            max_val = current_pixel;
+                        }
+                    }
+                }
+            }
+            output[i * width + j] = max_val - min_val;
+        }
+    }
+}
+
+// L2 size of the current core (POSIX sysconf where available)
+static long l2_cache_bytes() {
+#if defined(_SC_LEVEL2_CACHE_SIZE)
+    const long bytes = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (bytes > 0) return bytes;
+#endif
+    return DEFAULT_L2_BYTES;
+}
+
+// Largest side T with (T + 2r)^2 input + T^2 output bytes in half the L2
+int Tile_Size_For_Kernel(const int kernel_size) {
+    const int kernel_radius = kernel_size / 2;
+    const long budget = l2_cache_bytes() / 2;
+
+    int tile = static_cast<int>(std::sqrt(static_cast<double>(budget)));
+    while (tile > 32) {
+        const long halo_side = tile + 2L * kernel_radius;
+        if (halo_side * halo_side + static_cast<long>(tile) * tile <= budget) break;
+        tile -= 16;
+    }
+    return std::max(tile, 32);
+}
+
+// Tile of at most `side`, cut until there are TILES_PER_THREAD tiles per
+// thread: rows first, since a wide tile keeps whole input rows in use, then
+// columns
+static void tile_shape(const int width, const int height, const int side,
+                       int& tile_width, int& tile_height) {
+
+    const long min_tiles = static_cast<long>(TILES_PER_THREAD) * omp_get_max_threads();
+
+    tile_width = std::max(1, std::min(width, side));
+    const long tiles_x = (width + tile_width - 1) / tile_width;
+    const long rows_needed = (min_tiles + tiles_x - 1) / tiles_x;
+    tile_height = std::max(1, std::min(height, side));
+    tile_height = std::min(tile_height, std::max(MIN_TILE_SIDE, static_cast<int>((height + rows_needed - 1) / rows_needed)));
+
+    const long tiles_y = (height + tile_height - 1) / tile_height;
+    if (tiles_x * tiles_y < min_tiles) {
+        const long columns_needed = (min_tiles + tiles_y - 1) / tiles_y;
+        tile_width = std::min(tile_width, std::max(MIN_TILE_SIDE, static_cast<int>((width + columns_needed - 1) / columns_needed)));
+    }
+}
+
+template <bool ERODE>
+static void tiled_filter(const std::vector<unsigned char>& input,
+                         std::vector<unsigned char>& output,
+                         const int width, const int height, const int kernel_size,
+                         const int tile_size) {
+
+    const int kernel_radius = kernel_size / 2;
+    output.resize(width * height);
+
+    int tile_width, tile_height;
+    tile_shape(width, height, tile_size > 0 ? tile_size : Tile_Size_For_Kernel(kernel_size),
+               tile_width, tile_height);
+    const int tiles_x = (width + tile_width - 1) / tile_width;
+    const int tiles_y = (height + tile_height - 1) / tile_height;
+    const int num_tiles = tiles_x * tiles_y;
+
+    // tiles numbered down each column band, contiguous chunks per thread, so
+    // a thread's consecutive tiles share the halo rows it just loaded
+    #pragma omp parallel for schedule(static)
+    for (int t = 0; t < num_tiles; ++t) {
+        const int x0 = (t / tiles_y) * tile_width;
+        const int y0 = (t % tiles_y) * tile_height;
+        const int x1 = std::min(width, x0 + tile_width);
+        const int y1 = std::min(height, y0 + tile_height);
+
+        for (int i = y0; i < y1; ++i) {
+            for (int j = x0; j < x1; ++j) {
+                unsigned char val = ERODE ? 255 : 0;
+
+                for (int u = -kernel_radius; u <= kernel_radius; ++u) {
+                    for (int v = -kernel_radius; v <= kernel_radius; ++v) {
+                        int ni = i + u;
+                        int nj = j + v;
+
+                        if (ni >= 0 && ni < height && nj >= 0 && nj < width) {
+                            unsigned char current_pixel = input[ni * width + nj];
+                            if (ERODE ? current_pixel < val : current_pixel > val) {
+                                val = current_pixel;
+                            }
+                        }
+                    }
+                }
+                output[i * width + j] = val;
+            }
+        }
+    }
+}
+
+void Dilate_Parallel_Tiled(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height, const int kernel_size,
+                           const int tile_size) {
+
+    tiled_filter<false>(input, output, width, height, kernel_size, tile_size);
+}
+
+void Erode_Parallel_Tiled(const std::vector<unsigned char>& input,
+                          std::vector<unsigned char>& output,
+                          const int width, const int height, const int kernel_size,
+                          const int tile_size) {
+
+    tiled_filter<true>(input, output, width, height, kernel_size, tile_size);
+}
+
+void Opening_Parallel_Tiled(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height, const int kernel_size,
+                            const int tile_size) {
+
+    std::vector<unsigned char> temp;
+
+    Erode_Parallel_Tiled(input, temp, width, height, kernel_size, tile_size);
+    Dilate_Parallel_Tiled(temp, output, width, height, kernel_size, tile_size);
+}
+
+void Dilate_Parallel_Tiled(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height, const int kernel_size) {
+
+    Dilate_Parallel_Tiled(input, output, width, height, kernel_size, 0);
+}
+
+void Erode_Parallel_Tiled(const std::vector<unsigned char>& input,
+                          std::vector<unsigned char>& output,
+                          const int width, const int height, const int kernel_size) {
+
+    Erode_Parallel_Tiled(input, output, width, height, kernel_size, 0);
+}
+
+void Opening_Parallel_Tiled(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height, const int kernel_size) {
+
+    Opening_Parallel_Tiled(input, output, width, height, kernel_size, 0);
+}
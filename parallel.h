@@ -17,4 +17,48 @@ void Opening_Parallel(const std::vector<unsigned char>& input,
                       std::vector<unsigned char>& output,
                       const int width, const int height, const int kernel_size);
 
+// --- BACKEND POR TESELAS 2D ---
+//
+// Tiles start as squares sized so a tile plus its halo fits in L2, then are
+// cut (height first) until there are at least 4 tiles per OpenMP thread.
+// Tiles are numbered down each column band and every thread takes a
+// contiguous run, so consecutive tiles share the halo rows just loaded.
+
+// L2-sized tile side used for a given kernel
+int Tile_Size_For_Kernel(const int kernel_size);
+
+void Dilate_Parallel_Tiled(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height, const int kernel_size);
+
+void Erode_Parallel_Tiled(const std::vector<unsigned char>& input,
+                          std::vector<unsigned char>& output,
+                          const int width, const int height, const int kernel_size);
+
+void Opening_Parallel_Tiled(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height, const int kernel_size);
+
+// Same, starting from tile_size x tile_size tiles instead of the L2-derived
+// side (tile_size <= 0 keeps Tile_Size_For_Kernel)
+void Dilate_Parallel_Tiled(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height, const int kernel_size,
+                           const int tile_size);
+
+void Erode_Parallel_Tiled(const std::vector<unsigned char>& input,
+                          std::vector<unsigned char>& output,
+                          const int width, const int height, const int kernel_size,
+                          const int tile_size);
+
+void Opening_Parallel_Tiled(const std::vector<unsigned char>& input,
+                            std::vector<unsigned char>& output,
+                            const int width, const int height, const int kernel_size,
+                            const int tile_size);
+
+// Morphological gradient (dilation - erosion) in a single fused window pass
+void Gradient_Parallel(const std::vector<unsigned char>& input,
+                       std::vector<unsigned char>& output,
+                       const int width, const int height, const int kernel_size);
+
 #endif // PARALLEL_H
@@ -0,0 +1,193 @@
+#include "path_opening.h"
+#include <algorithm>
+#include <cstdint>
+#include <omp.h>
+
+namespace {
+
+// Sweeps run in abstract coordinates: line a = 0..A-1 in processing order,
+// position b = 0..B-1 inside the line. Every cone has its successors either
+// on the previous line or earlier on the same line, so one pass in this
+// order is a topological order of the cone's DAG.
+enum class ConeShape {
+    Fan,    // successors (a-1, b-1), (a-1, b), (a-1, b+1)
+    Corner  // successors (a-1, b), (a-1, b-1), (a, b-1)
+};
+
+struct Cone {
+    ConeShape shape;
+    bool column_major;  // lines are columns instead of rows
+    int row_dir;        // forward sweep direction (+1 top-down, -1 bottom-up)
+    int col_dir;        // forward sweep direction (+1 left-right, -1 right-left)
+};
+
+// Vertical, horizontal, and the two diagonal cones
+const Cone CONES[4] = {
+    {ConeShape::Fan,    false, -1, +1},  // N-S: successors one row below
+    {ConeShape::Fan,    true,  +1, -1},  // E-W: successors one column to the right
+    {ConeShape::Corner, false, +1, -1},  // SW-NE: (i-1, j), (i-1, j+1), (i, j+1)
+    {ConeShape::Corner, false, -1, -1},  // NW-SE: (i+1, j), (i+1, j+1), (i, j+1)
+};
+
+struct Level {
+    unsigned char value;        // binary set is input >= value ...
+    unsigned char restrict_to;  // ... intersected with output >= restrict_to
+};
+
+// One sweep over a cone. Line buffers hold the states of the previous and
+// current line: state 0 is the longest path starting on a kept pixel,
+// state k > 0 the longest one starting with k gap pixels.
+//
+// Forward: writes state 0 of every pixel into `lengths`.
+// Backward: reads the forward length and overwrites `lengths` with 1 when the
+// joint path through the pixel reaches `path_length`, 0 otherwise.
+void sweep_cone(const unsigned char* input, const unsigned char* output,
+                uint16_t* lengths, const int width, const int height,
+                const Cone& cone, const bool forward, const Level& level,
+                const int path_length, const int max_gap) {
+
+    const int row_dir = forward ? cone.row_dir : -cone.row_dir;
+    const int col_dir = forward ? cone.col_dir : -cone.col_dir;
+    const int num_lines = cone.column_major ? width : height;
+    const int line_len = cone.column_major ? height : width;
+    const int states = max_gap + 1;
+    const int clamp = path_length;
+
+    std::vector<uint16_t> prev(static_cast<size_t>(states) * line_len, 0);
+    std::vector<uint16_t> cur(static_cast<size_t>(states) * line_len, 0);
+    std::vector<int> best(states);
+
+    for (int a = 0; a < num_lines; ++a) {
+        for (int b = 0; b < line_len; ++b) {
+            int i, j;
+            if (cone.column_major) {
+                j = col_dir > 0 ? a : width - 1 - a;
+                i = row_dir > 0 ? b : height - 1 - b;
+            } else {
+                i = row_dir > 0 ? a : height - 1 - a;
+                j = col_dir > 0 ? b : width - 1 - b;
+            }
+            const int idx = i * width + j;
+
+            for (int k = 0; k < states; ++k) {
+                const uint16_t* p = &prev[static_cast<size_t>(k) * line_len];
+                const uint16_t* c = &cur[static_cast<size_t>(k) * line_len];
+                int m = 0;
+                if (a > 0) {
+                    m = p[b];
+                    if (b > 0) m = std::max<int>(m, p[b - 1]);
+                    if (cone.shape == ConeShape::Fan && b + 1 < line_len) m = std::max<int>(m, p[b + 1]);
+                }
+                if (cone.shape == ConeShape::Corner && b > 0) m = std::max<int>(m, c[b - 1]);
+                best[k] = m;
+            }
+
+            const bool fg = input[idx] >= level.value && output[idx] >= level.restrict_to;
+            if (fg) {
+                int m = 0;
+                for (int k = 0; k < states; ++k) m = std::max(m, best[k]);
+                cur[b] = static_cast<uint16_t>(std::min(clamp, m + 1));
+                for (int k = 1; k < states; ++k) cur[static_cast<size_t>(k) * line_len + b] = 0;
+            } else {
+                cur[b] = 0;
+                for (int k = 1; k < states; ++k) {
+                    cur[static_cast<size_t>(k) * line_len + b] =
+                        best[k - 1] > 0 ? static_cast<uint16_t>(std::min(clamp, best[k - 1] + 1)) : 0;
+                }
+            }
+
+            if (forward) {
+                lengths[idx] = cur[b];
+            } else {
+                lengths[idx] = (fg && lengths[idx] + cur[b] - 1 >= path_length) ? 1 : 0;
+            }
+        }
+        std::swap(prev, cur);
+    }
+}
+
+void path_opening(const std::vector<unsigned char>& input,
+                  std::vector<unsigned char>& output,
+                  const int width, const int height,
+                  const int path_length, const int max_gap) {
+
+    const int num_pixels = width * height;
+    output.assign(num_pixels, 0);
+    if (num_pixels == 0) return;
+
+    // lengths are clamped to path_length so they fit in 16 bits
+    const int length = std::max(1, std::min(path_length, 65535));
+    const int gaps = std::max(0, max_gap);
+
+    // distinct grey levels, ascending
+    bool present[256] = {};
+    for (int i = 0; i < num_pixels; ++i) present[input[i]] = true;
+    std::vector<unsigned char> levels;
+    for (int v = 0; v < 256; ++v) {
+        if (present[v]) levels.push_back(static_cast<unsigned char>(v));
+    }
+
+    // levels are processed in batches of (level, cone) tasks; a pixel kept at
+    // some level is kept at every lower one, so each batch only looks at
+    // pixels kept by the last level of the previous batch
+    const int batch = std::max(1, omp_get_max_threads() / 4);
+    std::vector<std::vector<uint16_t>> keep(static_cast<size_t>(batch) * 4,
+                                            std::vector<uint16_t>(num_pixels));
+    unsigned char restrict_level = 0;
+
+    for (size_t first = 0; first < levels.size(); first += batch) {
+        const int count = static_cast<int>(std::min<size_t>(batch, levels.size() - first));
+
+        #pragma omp parallel for collapse(2) schedule(dynamic)
+        for (int l = 0; l < count; ++l) {
+            for (int c = 0; c < 4; ++c) {
+                const Level level = {levels[first + l], restrict_level};
+                uint16_t* buf = keep[static_cast<size_t>(l) * 4 + c].data();
+                sweep_cone(input.data(), output.data(), buf, width, height,
+                           CONES[c], true, level, length, gaps);
+                sweep_cone(input.data(), output.data(), buf, width, height,
+                           CONES[c], false, level, length, gaps);
+            }
+        }
+
+        // merge the batch (ascending, so the highest kept level wins)
+        std::vector<int> kept(count, 0);
+        for (int l = 0; l < count; ++l) {
+            const unsigned char value = levels[first + l];
+            const uint16_t* k0 = keep[static_cast<size_t>(l) * 4 + 0].data();
+            const uint16_t* k1 = keep[static_cast<size_t>(l) * 4 + 1].data();
+            const uint16_t* k2 = keep[static_cast<size_t>(l) * 4 + 2].data();
+            const uint16_t* k3 = keep[static_cast<size_t>(l) * 4 + 3].data();
+            int any = 0;
+
+            #pragma omp parallel for schedule(static) reduction(max:any)
+            for (int i = 0; i < num_pixels; ++i) {
+                if (k0[i] | k1[i] | k2[i] | k3[i]) {
+                    output[i] = value;
+                    any = 1;
+                }
+            }
+            kept[l] = any;
+        }
+
+        if (!kept[count - 1]) break;
+        restrict_level = levels[first + count - 1];
+    }
+}
+
+} // namespace
+
+void Opening_Path_Parallel(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height, const int path_length) {
+
+    path_opening(input, output, width, height, path_length, 0);
+}
+
+void Opening_RobustPath_Parallel(const std::vector<unsigned char>& input,
+                                 std::vector<unsigned char>& output,
+                                 const int width, const int height,
+                                 const int path_length, const int max_gap) {
+
+    path_opening(input, output, width, height, path_length, max_gap);
+}
@@ -0,0 +1,26 @@
+#ifndef PATH_OPENING_H
+#define PATH_OPENING_H
+
+#include <vector>
+
+// --- APERTURAS POR CAMINOS (path openings, Talbot & Appleton) ---
+//
+// A pixel survives at grey level h if it lies on a path of at least
+// `path_length` pixels of value >= h inside one of the four adjacency cones
+// (vertical, horizontal and the two diagonals). Each binary level costs two
+// O(N) topological sweeps per cone; cones and grey levels are processed
+// concurrently. Paths shorter than the image never fit, so small images can
+// come out all zero.
+
+void Opening_Path_Parallel(const std::vector<unsigned char>& input,
+                           std::vector<unsigned char>& output,
+                           const int width, const int height, const int path_length);
+
+// Robust variant: paths may cross runs of up to `max_gap` pixels below the
+// level (gap pixels count towards the length but are not kept themselves)
+void Opening_RobustPath_Parallel(const std::vector<unsigned char>& input,
+                                 std::vector<unsigned char>& output,
+                                 const int width, const int height,
+                                 const int path_length, const int max_gap);
+
+#endif // PATH_OPENING_H
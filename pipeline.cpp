@@ -0,0 +1,133 @@
+#include "pipeline.h"
+#include "image_utils.h"
+#include "parallel.h"
+#include "libs/stb_image.h"
+#include "libs/stb_image_write.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <omp.h>
+
+namespace {
+
+struct PipelineItem {
+    int index = -1;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
+    unsigned char* decoded = nullptr;   // stbi buffer until converted
+    std::vector<unsigned char> pixels;
+};
+
+using ItemQueue = BoundedQueue<PipelineItem>;
+
+// Runs `threads` copies of `work` and closes `downstream` when the last one
+// returns; busy time and image counts go to `stats`
+template <typename Work>
+void start_stage(std::vector<std::thread>& pool, StageStats& stats, std::mutex& stats_mutex,
+                 ItemQueue* downstream, std::atomic<int>& live, Work work) {
+
+    live.store(stats.threads);
+    for (int t = 0; t < stats.threads; ++t) {
+        pool.emplace_back([&, downstream, work]() {
+            double busy = 0.0;
+            int images = 0;
+            work(busy, images);
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex);
+                stats.busy_time += busy;
+                stats.images += images;
+            }
+            if (live.fetch_sub(1) == 1 && downstream) downstream->close();
+        });
+    }
+}
+
+} // namespace
+
+PipelineStats Opening_Pipeline(const std::vector<std::string>& input_paths,
+                               const std::vector<std::string>& output_paths,
+                               const int kernel_size,
+                               const PipelineConfig& config) {
+
+    PipelineStats result;
+    const char* names[4] = {"decode", "convert", "morph", "encode"};
+    const int threads[4] = {std::max(1, config.decode_threads), std::max(1, config.convert_threads),
+                            1, std::max(1, config.encode_threads)};
+    result.stages.resize(4);
+    for (int s = 0; s < 4; ++s) {
+        result.stages[s].name = names[s];
+        result.stages[s].threads = threads[s];
+    }
+    const int morph_threads = std::max(1, config.morph_threads);
+
+    ItemQueue decoded(config.queue_capacity);
+    ItemQueue converted(config.queue_capacity);
+    ItemQueue filtered(config.queue_capacity);
+
+    const int num_inputs = static_cast<int>(std::min(input_paths.size(), output_paths.size()));
+    std::atomic<int> next_input{0};
+    std::atomic<int> live[4];
+    std::mutex stats_mutex;
+    std::vector<std::thread> pool;
+
+    double start = omp_get_wtime();
+
+    start_stage(pool, result.stages[0], stats_mutex, &decoded, live[0], [&](double& busy, int& images) {
+        for (int i = next_input.fetch_add(1); i < num_inputs; i = next_input.fetch_add(1)) {
+            double t0 = omp_get_wtime();
+            PipelineItem item;
+            item.index = i;
+            item.decoded = stbi_load(input_paths[i].c_str(), &item.width, &item.height, &item.channels, 0);
+            busy += omp_get_wtime() - t0;
+            if (!item.decoded) continue;
+            ++images;
+            decoded.push(std::move(item));
+        }
+    });
+
+    start_stage(pool, result.stages[1], stats_mutex, &converted, live[1], [&](double& busy, int& images) {
+        PipelineItem item;
+        while (decoded.pop(item)) {
+            double t0 = omp_get_wtime();
+            item.pixels = convert_to_grayscale(item.decoded, item.width, item.height, item.channels);
+            stbi_image_free(item.decoded);
+            item.decoded = nullptr;
+            busy += omp_get_wtime() - t0;
+            ++images;
+            converted.push(std::move(item));
+        }
+    });
+
+    start_stage(pool, result.stages[2], stats_mutex, &filtered, live[2], [&](double& busy, int& images) {
+        // the thread count is per calling thread, so this only affects the morph stage
+        omp_set_num_threads(morph_threads);
+        PipelineItem item;
+        while (converted.pop(item)) {
+            double t0 = omp_get_wtime();
+            std::vector<unsigned char> opened;
+            Opening_Parallel(item.pixels, opened, item.width, item.height, kernel_size);
+            item.pixels.swap(opened);
+            busy += omp_get_wtime() - t0;
+            ++images;
+            filtered.push(std::move(item));
+        }
+    });
+
+    start_stage(pool, result.stages[3], stats_mutex, nullptr, live[3], [&](double& busy, int& images) {
+        PipelineItem item;
+        while (filtered.pop(item)) {
+            double t0 = omp_get_wtime();
+            stbi_write_png(output_paths[item.index].c_str(), item.width, item.height, 1,
+                           item.pixels.data(), item.width);
+            busy += omp_get_wtime() - t0;
+            ++images;
+        }
+    });
+
+    for (std::thread& thread : pool) thread.join();
+
+    result.wall_time = omp_get_wtime() - start;
+    result.images = result.stages[3].images;
+    return result;
+}
@@ -0,0 +1,91 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// --- PIPELINE DECODIFICAR -> GRIS -> APERTURA -> CODIFICAR ---
+//
+// Each stage has its own threads and hands images to the next one through a
+// bounded queue, so image i+1 is decoded while image i is filtered and image
+// i-1 is encoded. A full queue blocks its producer, which caps memory at
+// about queue_capacity images per stage.
+
+// Blocking FIFO with a fixed capacity; pop() returns false once the queue
+// is closed and drained
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+    void push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&] { return items_.size() < capacity_; });
+        items_.push_back(std::move(item));
+        not_empty_.notify_one();
+    }
+
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [&] { return !items_.empty() || closed_; });
+        if (items_.empty()) return false;
+        item = std::move(items_.front());
+        items_.pop_front();
+        not_full_.notify_one();
+        return true;
+    }
+
+    // No more pushes will come
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+private:
+    size_t capacity_;
+    bool closed_ = false;
+    std::deque<T> items_;
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+};
+
+struct PipelineConfig {
+    int decode_threads = 2;
+    int convert_threads = 1;
+    int morph_threads = 2;    // OpenMP threads of the single Opening_Parallel stage
+    int encode_threads = 2;
+    int queue_capacity = 4;   // images per queue
+};
+
+struct StageStats {
+    std::string name;
+    int threads = 0;          // stage threads (morph: 1, running morph_threads OpenMP threads)
+    int images = 0;
+    double busy_time = 0.0;   // seconds summed over the stage's threads
+
+    // Busy fraction of the stage's threads over the pipeline wall time;
+    // a stage near 1 is the bottleneck
+    double utilization(double wall_time) const {
+        return (wall_time > 0.0 && threads > 0) ? busy_time / (wall_time * threads) : 0.0;
+    }
+};
+
+struct PipelineStats {
+    double wall_time = 0.0;
+    int images = 0;
+    std::vector<StageStats> stages;   // decode, convert, morph, encode
+};
+
+// Opens every input_paths[i] and writes the grayscale opening as a PNG to
+// output_paths[i]; unreadable inputs are skipped
+PipelineStats Opening_Pipeline(const std::vector<std::string>& input_paths,
+                               const std::vector<std::string>& output_paths,
+                               const int kernel_size,
+                               const PipelineConfig& config = PipelineConfig());
+
+#endif // PIPELINE_H
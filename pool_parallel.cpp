@@ -0,0 +1,101 @@
+#include "pool_parallel.h"
+#include "thread_pool.h"
+#include "morph_1d.h"
+#include <algorithm>
+
+// Target pixels per row block: small enough to balance, big enough that a
+// block outweighs a steal
+static const int POOL_BLOCK_PIXELS = 16 * 1024;
+
+// Same window as Dilate_Parallel / Erode_Parallel. The body copies sizes and
+// buffer pointers into locals first: read through the captured references,
+// they could alias the output stores and would be reloaded in the inner loops.
+template <typename Op>
+static void pool_filter(const std::vector<unsigned char>& input,
+                        std::vector<unsigned char>& output,
+                        const int width, const int height, const int kernel_size,
+                        ThreadPool& pool) {
+
+    output.resize(width * height);
+    if (width <= 0 || height <= 0) return;
+
+    const int grain = std::max(1, POOL_BLOCK_PIXELS / width);
+    const unsigned char* const in_data = input.data();
+    unsigned char* const out_data = output.data();
+
+    pool.parallel_for(height, grain, [in_data, out_data, width, height, kernel_size](int row_begin, int row_end) {
+        const unsigned char* const in = in_data;
+        unsigned char* const out = out_data;
+        const int w = width;
+        const int h = height;
+        const int kernel_radius = kernel_size / 2;
+        const Op op;
+
+        for (int i = row_begin; i < row_end; ++i) {
+            for (int j = 0; j < w; ++j) {
+                unsigned char best = Op::identity;
+
+                for (int u = -kernel_radius; u <= kernel_radius; ++u) {
+                    for (int v = -kernel_radius; v <= kernel_radius; ++v) {
+                        int ni = i + u;
+                        int nj = j + v;
+
+                        if (ni >= 0 && ni < h && nj >= 0 && nj < w) {
+                            best = op(best, in[ni * w + nj]);
+                        }
+                    }
+                }
+                out[i * w + j] = best;
+            }
+        }
+    });
+}
+
+void Dilate_Pool(const std::vector<unsigned char>& input,
+                 std::vector<unsigned char>& output,
+                 const int width, const int height, const int kernel_size,
+                 ThreadPool& pool) {
+
+    pool_filter<MaxOp>(input, output, width, height, kernel_size, pool);
+}
+
+void Erode_Pool(const std::vector<unsigned char>& input,
+                std::vector<unsigned char>& output,
+                const int width, const int height, const int kernel_size,
+                ThreadPool& pool) {
+
+    pool_filter<MinOp>(input, output, width, height, kernel_size, pool);
+}
+
+// Opening = erosion followed by dilation (both on the pool)
+void Opening_Pool(const std::vector<unsigned char>& input,
+                  std::vector<unsigned char>& output,
+                  const int width, const int height, const int kernel_size,
+                  ThreadPool& pool) {
+
+    std::vector<unsigned char> temp;
+
+    Erode_Pool(input, temp, width, height, kernel_size, pool);
+    Dilate_Pool(temp, output, width, height, kernel_size, pool);
+}
+
+void Dilate_Pool(const std::vector<unsigned char>& input,
+                 std::vector<unsigned char>& output,
+                 const int width, const int height, const int kernel_size) {
+
+    Dilate_Pool(input, output, width, height, kernel_size, Default_Thread_Pool());
+}
+
+void Erode_Pool(const std::vector<unsigned char>& input,
+                std::vector<unsigned char>& output,
+                const int width, const int height, const int kernel_size) {
+
+    Erode_Pool(input, output, width, height, kernel_size, Default_Thread_Pool());
+}
+
+void Opening_Pool(const std::vector<unsigned char>& input,
+                  std::vector<unsigned char>& output,
+                  const int width, const int height, const int kernel_size) {
+
+    Opening_Pool(input, output, width, height, kernel_size, Default_Thread_Pool());
+}
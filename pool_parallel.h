@@ -0,0 +1,42 @@
+#ifndef POOL_PARALLEL_H
+#define POOL_PARALLEL_H
+
+#include <vector>
+
+// --- OPERACIONES MORFOLÓGICAS PARALELAS (pool de hilos propio) ---
+//
+// Same functions and results as parallel.h, run on Default_Thread_Pool()
+// over blocks of rows. No OpenMP is involved, so these can be built and
+// called from programs that manage their own threads.
+
+void Dilate_Pool(const std::vector<unsigned char>& input,
+                 std::vector<unsigned char>& output,
+                 const int width, const int height, const int kernel_size);
+
+void Erode_Pool(const std::vector<unsigned char>& input,
+                std::vector<unsigned char>& output,
+                const int width, const int height, const int kernel_size);
+
+void Opening_Pool(const std::vector<unsigned char>& input,
+                  std::vector<unsigned char>& output,
+                  const int width, const int height, const int kernel_size);
+
+// Same operations on a caller-owned pool (the default pool is not touched)
+class ThreadPool;
+
+void Dilate_Pool(const std::vector<unsigned char>& input,
+                 std::vector<unsigned char>& output,
+                 const int width, const int height, const int kernel_size,
+                 ThreadPool& pool);
+
+void Erode_Pool(const std::vector<unsigned char>& input,
+                std::vector<unsigned char>& output,
+                const int width, const int height, const int kernel_size,
+                ThreadPool& pool);
+
+void Opening_Pool(const std::vector<unsigned char>& input,
+                  std::vector<unsigned char>& output,
+                  const int width, const int height, const int kernel_size,
+                  ThreadPool& pool);
+
+#endif // POOL_PARALLEL_H
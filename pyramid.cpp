@@ -0,0 +1,88 @@
+#include "pyramid.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <omp.h>
+
+// Radius left on the reduced level when the factor is chosen automatically
+static const int PYRAMID_TARGET_RADIUS = 4;
+
+void Opening_Pyramid_Parallel(const std::vector<unsigned char>& input,
+                              std::vector<unsigned char>& output,
+                              const int width, const int height, const int kernel_size,
+                              const int factor) {
+
+    const int kernel_radius = kernel_size / 2;
+    const int s = factor > 0 ? factor : std::max(1, kernel_radius / PYRAMID_TARGET_RADIUS);
+
+    if (s == 1) {
+        Opening_Parallel(input, output, width, height, kernel_size);
+        return;
+    }
+
+    const int small_w = (width + s - 1) / s;
+    const int small_h = (height + s - 1) / s;
+    const int small_radius = (kernel_radius + s / 2) / s;
+
+    // min-pool: every small pixel is <= the block it stands for
+    std::vector<unsigned char> small(small_w * small_h);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < small_h; ++i) {
+        const int y1 = std::min(height, (i + 1) * s);
+        for (int j = 0; j < small_w; ++j) {
+            const int x1 = std::min(width, (j + 1) * s);
+            unsigned char min_val = 255;
+            for (int y = i * s; y < y1; ++y) {
+                for (int x = j * s; x < x1; ++x) {
+                    min_val = std::min(min_val, input[y * width + x]);
+                }
+            }
+            small[i * small_w + j] = min_val;
+        }
+    }
+
+    std::vector<unsigned char> small_opened;
+    Opening_Parallel(small, small_opened, small_w, small_h, 2 * small_radius + 1);
+
+    output.resize(width * height);
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < height; ++y) {
+        const unsigned char* src = &small_opened[(y / s) * small_w];
+        for (int x = 0; x < width; ++x) {
+            output[y * width + x] = src[x / s];
+        }
+    }
+}
+
+ApproximationError Approximation_Error(const std::vector<unsigned char>& approx,
+                                       const std::vector<unsigned char>& exact) {
+
+    ApproximationError err;
+    const int n = static_cast<int>(std::min(approx.size(), exact.size()));
+    if (n == 0) return err;
+
+    long long sum_abs = 0;
+    long long sum_sq = 0;
+    long long exact_count = 0;
+    int max_abs = 0;
+
+    #pragma omp parallel for schedule(static) reduction(+:sum_abs, sum_sq, exact_count) reduction(max:max_abs)
+    for (int i = 0; i < n; ++i) {
+        const int d = std::abs(static_cast<int>(approx[i]) - static_cast<int>(exact[i]));
+        sum_abs += d;
+        sum_sq += static_cast<long long>(d) * d;
+        exact_count += (d == 0);
+        max_abs = std::max(max_abs, d);
+    }
+
+    err.mean_abs_error = static_cast<double>(sum_abs) / n;
+    err.max_abs_error = max_abs;
+    err.fraction_exact = static_cast<double>(exact_count) / n;
+    const double mse = static_cast<double>(sum_sq) / n;
+    err.psnr_db = mse > 0.0 ? 10.0 * std::log10(255.0 * 255.0 / mse)
+                            : std::numeric_limits<double>::infinity();
+    return err;
+}
@@ -0,0 +1,30 @@
+#ifndef PYRAMID_H
+#define PYRAMID_H
+
+#include <vector>
+
+// --- APROXIMACIÓN MULTIESCALA PARA KERNELS GRANDES ---
+//
+// The image is min-pooled by `factor`, opened with the kernel scaled down by
+// the same factor, and upsampled (nearest). Min-pooling keeps the result
+// below the input everywhere, like a true opening. factor <= 0 picks one
+// that leaves a kernel of about 9x9 on the small level. Meant for previews
+// with kernel sizes well above 51; check the cost with Approximation_Error.
+
+void Opening_Pyramid_Parallel(const std::vector<unsigned char>& input,
+                              std::vector<unsigned char>& output,
+                              const int width, const int height, const int kernel_size,
+                              const int factor = 0);
+
+struct ApproximationError {
+    double mean_abs_error = 0.0;
+    int max_abs_error = 0;
+    double psnr_db = 0.0;          // infinite when the images are identical
+    double fraction_exact = 0.0;   // pixels with no error
+};
+
+// Error of an approximate result against the exact one (e.g. Opening_Parallel)
+ApproximationError Approximation_Error(const std::vector<unsigned char>& approx,
+                                       const std::vector<unsigned char>& exact);
+
+#endif // PYRAMID_H
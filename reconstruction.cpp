@@ -0,0 +1,305 @@
+#include "reconstruction.h"
+#include "union_find.h"
+#include <algorithm>
+#include <deque>
+#include <omp.h>
+
+// Rows [first, last) handled by `thread` out of `num_threads`
+static void strip_rows(const int height, const int thread, const int num_threads, int& first, int& last) {
+    first = static_cast<int>(static_cast<long long>(height) * thread / num_threads);
+    last = static_cast<int>(static_cast<long long>(height) * (thread + 1) / num_threads);
+}
+
+void Reconstruct_Dilation_Parallel(const std::vector<unsigned char>& marker,
+                                   const std::vector<unsigned char>& mask,
+                                   std::vector<unsigned char>& output,
+                                   const int width, const int height) {
+
+    const int num_pixels = width * height;
+    output.resize(num_pixels);
+    unsigned char* J = output.data();
+    const unsigned char* I = mask.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int p = 0; p < num_pixels; ++p) {
+        J[p] = std::min(marker[p], mask[p]);
+    }
+
+    std::vector<std::vector<int>> seeds;
+
+    #pragma omp parallel
+    {
+        const int num_threads = omp_get_num_threads();
+        const int t = omp_get_thread_num();
+        int r0, r1;
+        strip_rows(height, t, num_threads, r0, r1);
+
+        #pragma omp single
+        seeds.resize(num_threads);
+
+        // rows just outside the strip, frozen before anyone starts scanning
+        std::vector<unsigned char> above(width, 0), below(width, 0);
+        if (r0 > 0 && r0 < r1) std::copy(J + (r0 - 1) * width, J + r0 * width, above.begin());
+        if (r1 < height && r0 < r1) std::copy(J + r1 * width, J + (r1 + 1) * width, below.begin());
+
+        #pragma omp barrier
+
+        // raster scan: upper and left neighbours
+        for (int i = r0; i < r1; ++i) {
+            const unsigned char* up = (i == r0) ? above.data() : J + (i - 1) * width;
+            for (int j = 0; j < width; ++j) {
+                unsigned char m = J[i * width + j];
+                if (j > 0) m = std::max(m, J[i * width + j - 1]);
+                if (i > 0) {
+                    m = std::max(m, up[j]);
+                    if (j > 0) m = std::max(m, up[j - 1]);
+                    if (j + 1 < width) m = std::max(m, up[j + 1]);
+                }
+                J[i * width + j] = std::min(m, I[i * width + j]);
+            }
+        }
+
+        // anti-raster scan: lower and right neighbours
+        for (int i = r1 - 1; i >= r0; --i) {
+            const unsigned char* down = (i == r1 - 1) ? below.data() : J + (i + 1) * width;
+            for (int j = width - 1; j >= 0; --j) {
+                unsigned char m = J[i * width + j];
+                if (j + 1 < width) m = std::max(m, J[i * width + j + 1]);
+                if (i + 1 < height) {
+                    m = std::max(m, down[j]);
+                    if (j > 0) m = std::max(m, down[j - 1]);
+                    if (j + 1 < width) m = std::max(m, down[j + 1]);
+                }
+                J[i * width + j] = std::min(m, I[i * width + j]);
+            }
+        }
+
+        #pragma omp barrier
+
+        // pixels that can still raise a neighbour seed the FIFO pass
+        std::vector<int>& local = seeds[t];
+        for (int i = r0; i < r1; ++i) {
+            for (int j = 0; j < width; ++j) {
+                const int p = i * width + j;
+                bool seed = false;
+                for (int u = -1; u <= 1 && !seed; ++u) {
+                    for (int v = -1; v <= 1; ++v) {
+                        const int ni = i + u, nj = j + v;
+                        if ((u == 0 && v == 0) || ni < 0 || ni >= height || nj < 0 || nj >= width) continue;
+                        const int q = ni * width + nj;
+                        if (J[q] < J[p] && J[q] < I[q]) {
+                            seed = true;
+                            break;
+                        }
+                    }
+                }
+                if (seed) local.push_back(p);
+            }
+        }
+    }
+
+    std::deque<int> fifo;
+    for (const std::vector<int>& local : seeds) fifo.insert(fifo.end(), local.begin(), local.end());
+
+    while (!fifo.empty()) {
+        const int p = fifo.front();
+        fifo.pop_front();
+        const int i = p / width, j = p % width;
+
+        for (int u = -1; u <= 1; ++u) {
+            for (int v = -1; v <= 1; ++v) {
+                const int ni = i + u, nj = j + v;
+                if ((u == 0 && v == 0) || ni < 0 || ni >= height || nj < 0 || nj >= width) continue;
+                const int q = ni * width + nj;
+                if (J[q] < J[p] && I[q] != J[q]) {
+                    J[q] = std::min(J[p], I[q]);
+                    fifo.push_back(q);
+                }
+            }
+        }
+    }
+}
+
+static void complement(const std::vector<unsigned char>& input, std::vector<unsigned char>& output) {
+    const int n = static_cast<int>(input.size());
+    output.resize(n);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i) {
+        output[i] = 255 - input[i];
+    }
+}
+
+// Erosion-reconstruction is dilation-reconstruction of the complements
+void Reconstruct_Erosion_Parallel(const std::vector<unsigned char>& marker,
+                                  const std::vector<unsigned char>& mask,
+                                  std::vector<unsigned char>& output,
+                                  const int width, const int height) {
+
+    std::vector<unsigned char> marker_c, mask_c, result_c;
+    complement(marker, marker_c);
+    complement(mask, mask_c);
+    Reconstruct_Dilation_Parallel(marker_c, mask_c, result_c, width, height);
+    complement(result_c, output);
+}
+
+void HMaxima_Parallel(const std::vector<unsigned char>& input,
+                      std::vector<unsigned char>& output,
+                      const int width, const int height, const int h) {
+
+    const int n = width * height;
+    std::vector<unsigned char> lowered(n);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i) {
+        lowered[i] = static_cast<unsigned char>(std::max(0, input[i] - h));
+    }
+    Reconstruct_Dilation_Parallel(lowered, input, output, width, height);
+}
+
+void HMinima_Parallel(const std::vector<unsigned char>& input,
+                      std::vector<unsigned char>& output,
+                      const int width, const int height, const int h) {
+
+    const int n = width * height;
+    std::vector<unsigned char> raised(n);
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < n; ++i) {
+        raised[i] = static_cast<unsigned char>(std::min(255, input[i] + h));
+    }
+    Reconstruct_Erosion_Parallel(raised, input, output, width, height);
+}
+
+// Flat zones via union-find (strips in parallel, seams merged serially),
+// then zones with a strictly higher (or lower) neighbour are discarded
+static int regional_extrema(const std::vector<unsigned char>& input,
+                            std::vector<int>& labels,
+                            const int width, const int height, const bool maxima) {
+
+    const int num_pixels = width * height;
+    labels.assign(num_pixels, 0);
+    if (num_pixels == 0) return 0;
+
+    std::vector<int> parent(num_pixels);
+    std::vector<int> root(num_pixels);
+    std::vector<unsigned char> not_extremum(num_pixels, 0);
+    std::vector<int> strip_starts;
+    const unsigned char* f = input.data();
+    int* P = parent.data();
+
+    #pragma omp parallel
+    {
+        const int num_threads = omp_get_num_threads();
+        const int t = omp_get_thread_num();
+        int r0, r1;
+        strip_rows(height, t, num_threads, r0, r1);
+
+        #pragma omp single
+        strip_starts.resize(num_threads);
+        strip_starts[t] = r0;
+
+        for (int i = r0; i < r1; ++i) {
+            for (int j = 0; j < width; ++j) {
+                const int p = i * width + j;
+                P[p] = p;
+                if (j > 0 && f[p - 1] == f[p]) uf_union(P, p, p - 1);
+                if (i > r0) {
+                    for (int v = -1; v <= 1; ++v) {
+                        const int nj = j + v;
+                        if (nj >= 0 && nj < width && f[p - width + v] == f[p]) uf_union(P, p, p - width + v);
+                    }
+                }
+            }
+        }
+
+        #pragma omp barrier
+        #pragma omp single
+        {
+            for (size_t s = 1; s < strip_starts.size(); ++s) {
+                const int i = strip_starts[s];
+                if (i <= 0 || i >= height) continue;
+                for (int j = 0; j < width; ++j) {
+                    const int p = i * width + j;
+                    for (int v = -1; v <= 1; ++v) {
+                        const int nj = j + v;
+                        if (nj >= 0 && nj < width && f[p - width + v] == f[p]) uf_union(P, p, p - width + v);
+                    }
+                }
+            }
+        }
+
+        #pragma omp for schedule(static)
+        for (int p = 0; p < num_pixels; ++p) {
+            root[p] = uf_root(P, p);
+        }
+
+        #pragma omp for schedule(static)
+        for (int i = 0; i < height; ++i) {
+            for (int j = 0; j < width; ++j) {
+                const int p = i * width + j;
+                bool beaten = false;
+                for (int u = -1; u <= 1 && !beaten; ++u) {
+                    for (int v = -1; v <= 1; ++v) {
+                        const int ni = i + u, nj = j + v;
+                        if (ni < 0 || ni >= height || nj < 0 || nj >= width) continue;
+                        const unsigned char q = f[ni * width + nj];
+                        if (maxima ? q > f[p] : q < f[p]) {
+                            beaten = true;
+                            break;
+                        }
+                    }
+                }
+                if (beaten) {
+                    #pragma omp atomic write
+                    not_extremum[root[p]] = 1;
+                }
+            }
+        }
+    }
+
+    // consecutive labels in raster order of each zone's first pixel
+    std::vector<int> zone_label(num_pixels, 0);
+    int count = 0;
+    for (int p = 0; p < num_pixels; ++p) {
+        if (root[p] == p && !not_extremum[p]) zone_label[p] = ++count;
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int p = 0; p < num_pixels; ++p) {
+        labels[p] = zone_label[root[p]];
+    }
+    return count;
+}
+
+int Regional_Maxima_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<int>& labels,
+                             const int width, const int height) {
+
+    return regional_extrema(input, labels, width, height, true);
+}
+
+int Regional_Minima_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<int>& labels,
+                             const int width, const int height) {
+
+    return regional_extrema(input, labels, width, height, false);
+}
+
+int Extended_Maxima_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<int>& labels,
+                             const int width, const int height, const int h) {
+
+    std::vector<unsigned char> hmax;
+    HMaxima_Parallel(input, hmax, width, height, h);
+    return Regional_Maxima_Parallel(hmax, labels, width, height);
+}
+
+int Extended_Minima_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<int>& labels,
+                             const int width, const int height, const int h) {
+
+    std::vector<unsigned char> hmin;
+    HMinima_Parallel(input, hmin, width, height, h);
+    return Regional_Minima_Parallel(hmin, labels, width, height);
+}
@@ -0,0 +1,54 @@
+#ifndef RECONSTRUCTION_H
+#define RECONSTRUCTION_H
+
+#include <vector>
+
+// --- RECONSTRUCCIÓN MORFOLÓGICA Y EXTREMOS REGIONALES ---
+//
+// 8-connectivity throughout.
+
+// Reconstruction by dilation of `marker` under `mask` (marker <= mask).
+// Hybrid algorithm (Vincent): raster/anti-raster scans run in parallel on
+// row strips, then a FIFO pass finishes the propagation across strips.
+void Reconstruct_Dilation_Parallel(const std::vector<unsigned char>& marker,
+                                   const std::vector<unsigned char>& mask,
+                                   std::vector<unsigned char>& output,
+                                   const int width, const int height);
+
+// Reconstruction by erosion of `marker` above `mask` (marker >= mask)
+void Reconstruct_Erosion_Parallel(const std::vector<unsigned char>& marker,
+                                  const std::vector<unsigned char>& mask,
+                                  std::vector<unsigned char>& output,
+                                  const int width, const int height);
+
+// Suppresses maxima whose dynamic is below h: R_f(f - h)
+void HMaxima_Parallel(const std::vector<unsigned char>& input,
+                      std::vector<unsigned char>& output,
+                      const int width, const int height, const int h);
+
+// Fills minima whose dynamic is below h: R*_f(f + h)
+void HMinima_Parallel(const std::vector<unsigned char>& input,
+                      std::vector<unsigned char>& output,
+                      const int width, const int height, const int h);
+
+// Labels regional maxima/minima (flat zones with no higher/lower neighbour)
+// 1..n, 0 elsewhere. Flat zones are found with a strip-parallel union-find.
+// Returns the number of extrema.
+int Regional_Maxima_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<int>& labels,
+                             const int width, const int height);
+
+int Regional_Minima_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<int>& labels,
+                             const int width, const int height);
+
+// Regional maxima of the h-maxima transform: one marker per significant peak
+int Extended_Maxima_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<int>& labels,
+                             const int width, const int height, const int h);
+
+int Extended_Minima_Parallel(const std::vector<unsigned char>& input,
+                             std::vector<int>& labels,
+                             const int width, const int height, const int h);
+
+#endif // RECONSTRUCTION_H
@@ -0,0 +1,45 @@
+#ifndef RECT_H
+#define RECT_H
+
+#include <algorithm>
+
+// Axis-aligned pixel rectangle [x, x + width) x [y, y + height)
+struct Rect {
+    int x;
+    int y;
+    int width;
+    int height;
+};
+
+inline bool rect_empty(const Rect& r) {
+    return r.width <= 0 || r.height <= 0;
+}
+
+// Grows the rectangle by `margin` pixels on every side
+inline Rect expand_rect(const Rect& r, const int margin) {
+    return Rect{r.x - margin, r.y - margin, r.width + 2 * margin, r.height + 2 * margin};
+}
+
+inline Rect clip_rect(const Rect& r, const int width, const int height) {
+    const int x0 = std::max(r.x, 0);
+    const int y0 = std::max(r.y, 0);
+    const int x1 = std::min(r.x + r.width, width);
+    const int y1 = std::min(r.y + r.height, height);
+    return Rect{x0, y0, std::max(0, x1 - x0), std::max(0, y1 - y0)};
+}
+
+inline bool rects_overlap(const Rect& a, const Rect& b) {
+    return a.x < b.x + b.width && b.x < a.x + a.width &&
+           a.y < b.y + b.height && b.y < a.y + a.height;
+}
+
+// Smallest rectangle containing both
+inline Rect bounding_rect(const Rect& a, const Rect& b) {
+    const int x0 = std::min(a.x, b.x);
+    const int y0 = std::min(a.y, b.y);
+    const int x1 = std::max(a.x + a.width, b.x + b.width);
+    const int y1 = std::max(a.y + a.height, b.y + b.height);
+    return Rect{x0, y0, x1 - x0, y1 - y0};
+}
+
+#endif // RECT_H
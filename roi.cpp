@@ -0,0 +1,101 @@
+#include "roi.h"
+#include "morph_1d.h"
+#include <algorithm>
+#include <omp.h>
+
+// Small crops are faster on the calling thread than with a fork/join
+static const int ROI_PARALLEL_MIN_PIXELS = 64 * 1024;
+
+// Erodes/dilates `src` (covering src_rect of the image) into `dst` (covering
+// dst_rect). Windows are clipped to the full image, so src_rect must contain
+// dst_rect grown by `radius` (clipped to the image). Separable van Herk passes.
+static void morph_region(const unsigned char* src, const Rect& src_rect,
+                         unsigned char* dst, const Rect& dst_rect,
+                         const int width, const int height,
+                         const int radius, const bool erode) {
+
+    const int row0 = std::max(0, dst_rect.y - radius);
+    const int row1 = std::min(height, dst_rect.y + dst_rect.height + radius);
+    const int col0 = std::max(0, dst_rect.x - radius);
+    const int col1 = std::min(width, dst_rect.x + dst_rect.width + radius);
+    const int rows = row1 - row0;
+    const int seg = col1 - col0;
+    const bool parallel = static_cast<long long>(rows) * seg >= ROI_PARALLEL_MIN_PIXELS;
+
+    // horizontal pass over the rows the vertical windows need
+    std::vector<unsigned char> horiz(static_cast<size_t>(rows) * dst_rect.width);
+
+    #pragma omp parallel if(parallel)
+    {
+        VanHerkScratch scratch;
+        std::vector<unsigned char> line(std::max(seg, rows));
+
+        #pragma omp for schedule(static)
+        for (int r = 0; r < rows; ++r) {
+            const unsigned char* src_row = src + static_cast<size_t>(row0 + r - src_rect.y) * src_rect.width
+                                               + (col0 - src_rect.x);
+            if (erode) erode_1d(src_row, 1, line.data(), 1, seg, radius, scratch);
+            else       dilate_1d(src_row, 1, line.data(), 1, seg, radius, scratch);
+            std::copy(line.begin() + (dst_rect.x - col0), line.begin() + (dst_rect.x - col0) + dst_rect.width,
+                      horiz.begin() + static_cast<size_t>(r) * dst_rect.width);
+        }
+
+        #pragma omp for schedule(static)
+        for (int c = 0; c < dst_rect.width; ++c) {
+            if (erode) erode_1d(&horiz[c], dst_rect.width, line.data(), 1, rows, radius, scratch);
+            else       dilate_1d(&horiz[c], dst_rect.width, line.data(), 1, rows, radius, scratch);
+            for (int r = 0; r < dst_rect.height; ++r) {
+                dst[static_cast<size_t>(r) * dst_rect.width + c] = line[dst_rect.y - row0 + r];
+            }
+        }
+    }
+}
+
+static void single_stage_roi(const std::vector<unsigned char>& input,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height, const int kernel_size,
+                             const Rect& roi, const bool erode) {
+
+    const Rect region = clip_rect(roi, width, height);
+    output.resize(static_cast<size_t>(region.width) * region.height);
+    if (rect_empty(region)) return;
+
+    const Rect full = {0, 0, width, height};
+    morph_region(input.data(), full, output.data(), region, width, height, kernel_size / 2, erode);
+}
+
+void Erode_ROI_Parallel(const std::vector<unsigned char>& input,
+                        std::vector<unsigned char>& output,
+                        const int width, const int height, const int kernel_size,
+                        const Rect& roi) {
+
+    single_stage_roi(input, output, width, height, kernel_size, roi, true);
+}
+
+void Dilate_ROI_Parallel(const std::vector<unsigned char>& input,
+                         std::vector<unsigned char>& output,
+                         const int width, const int height, const int kernel_size,
+                         const Rect& roi) {
+
+    single_stage_roi(input, output, width, height, kernel_size, roi, false);
+}
+
+// Erosion is only evaluated on ROI + radius, the part the dilation reads
+void Opening_ROI_Parallel(const std::vector<unsigned char>& input,
+                          std::vector<unsigned char>& output,
+                          const int width, const int height, const int kernel_size,
+                          const Rect& roi) {
+
+    const Rect region = clip_rect(roi, width, height);
+    output.resize(static_cast<size_t>(region.width) * region.height);
+    if (rect_empty(region)) return;
+
+    const int kernel_radius = kernel_size / 2;
+    const Rect full = {0, 0, width, height};
+    const Rect eroded_rect = clip_rect(expand_rect(region, kernel_radius), width, height);
+
+    std::vector<unsigned char> eroded(static_cast<size_t>(eroded_rect.width) * eroded_rect.height);
+
+    morph_region(input.data(), full, eroded.data(), eroded_rect, width, height, kernel_radius, true);
+    morph_region(eroded.data(), eroded_rect, output.data(), region, width, height, kernel_radius, false);
+}
@@ -0,0 +1,29 @@
+#ifndef ROI_H
+#define ROI_H
+
+#include <vector>
+#include "rect.h"
+
+// --- OPERACIONES MORFOLÓGICAS SOBRE UNA REGIÓN DE INTERÉS ---
+//
+// Only the pixels inside `roi` (clipped to the image) are computed; output
+// is roi.width x roi.height, row-major. Input is read just over the ROI plus
+// its halo (one kernel radius per stage), so cost scales with the ROI and
+// not with the image. Values match the full-image operations.
+
+void Erode_ROI_Parallel(const std::vector<unsigned char>& input,
+                        std::vector<unsigned char>& output,
+                        const int width, const int height, const int kernel_size,
+                        const Rect& roi);
+
+void Dilate_ROI_Parallel(const std::vector<unsigned char>& input,
+                         std::vector<unsigned char>& output,
+                         const int width, const int height, const int kernel_size,
+                         const Rect& roi);
+
+void Opening_ROI_Parallel(const std::vector<unsigned char>& input,
+                          std::vector<unsigned char>& output,
+                          const int width, const int height, const int kernel_size,
+                          const Rect& roi);
+
+#endif // ROI_H
@@ -1,4 +1,5 @@
 #include "sequential.h"
+#include "morph_1d.h"
 
 // Dilation: takes the max value in the kernel
 void Dilate_Sequential(const std::vector<unsigned char>& input,
@@ -70,3 +71,34 @@ void Opening_Sequential(const std::vector<unsigned char>& input,
     Erode_Sequential(input, temp, width, height, kernel_size);
     Dilate_Sequential(temp, output, width, height, kernel_size);
 }
+
+// Square window = row pass then column pass (erosion and dilation both separable)
+static void separable_filter(const std::vector<unsigned char>& input,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height, const int kernel_radius,
+                             const bool erode, VanHerkScratch& scratch) {
+
+    std::vector<unsigned char> rows(width * height);
+    output.resize(width * height);
+
+    for (int i = 0; i < height; ++i) {
+        if (erode) erode_1d(&input[i * width], 1, &rows[i * width], 1, width, kernel_radius, scratch);
+        else       dilate_1d(&input[i * width], 1, &rows[i * width], 1, width, kernel_radius, scratch);
+    }
+    for (int j = 0; j < width; ++j) {
+        if (erode) erode_1d(&rows[j], width, &output[j], width, height, kernel_radius, scratch);
+        else       dilate_1d(&rows[j], width, &output[j], width, height, kernel_radius, scratch);
+    }
+}
+
+void Opening_Sequential_Separable(const std::vector<unsigned char>& input,
+                                  std::vector<unsigned char>& output,
+                                  const int width, const int height, const int kernel_size) {
+
+    const int kernel_radius = kernel_size / 2;
+    VanHerkScratch scratch;
+    std::vector<unsigned char> temp;
+
+    separable_filter(input, temp, width, height, kernel_radius, true, scratch);
+    separable_filter(temp, output, width, height, kernel_radius, false, scratch);
+}
@@ -17,4 +17,9 @@ void Opening_Sequential(const std::vector<unsigned char>& input,
                         std::vector<unsigned char>& output,
                         const int width, const int height, const int kernel_size);
 
+// Separable van Herk version: O(1) comparisons per pixel regardless of kernel
+void Opening_Sequential_Separable(const std::vector<unsigned char>& input,
+                                  std::vector<unsigned char>& output,
+                                  const int width, const int height, const int kernel_size);
+
 #endif // SEQUENTIAL_H
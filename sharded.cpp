@@ -0,0 +1,167 @@
+#include "sharded.h"
+#include "sequential.h"
+#include "image_utils.h"
+#include "libs/stb_image.h"
+#include "libs/stb_image_write.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <new>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define SHARDED_POSIX 1
+#endif
+
+#ifdef SHARDED_POSIX
+
+namespace {
+
+// Upper bound on workers (fixed so the segment has a plain layout)
+const int MAX_SHARD_PROCESSES = 256;
+
+static_assert(std::atomic<int>::is_always_lock_free, "shared counters need lock-free atomics");
+
+// Layout of the shared segment
+struct ShardQueue {
+    std::atomic<int> next;        // next image index to hand out
+    std::atomic<int> done;        // images finished (progress)
+    std::atomic<int> failed;      // workers that hit an error
+    double busy_time[MAX_SHARD_PROCESSES];
+    int images[MAX_SHARD_PROCESSES];
+};
+
+double now_seconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Worker body: pull indices until the queue is exhausted
+void shard_worker(ShardQueue* queue, const int worker,
+                  const std::vector<std::string>& input_paths,
+                  const std::vector<std::string>& output_paths,
+                  const int kernel_size) {
+
+    const int num_inputs = static_cast<int>(input_paths.size());
+    double busy = 0.0;
+    int images = 0;
+
+    for (int i = queue->next.fetch_add(1); i < num_inputs; i = queue->next.fetch_add(1)) {
+        int width, height, channels;
+        unsigned char* data = stbi_load(input_paths[i].c_str(), &width, &height, &channels, 0);
+        if (data) {
+            std::vector<unsigned char> gray = convert_to_grayscale(data, width, height, channels);
+            stbi_image_free(data);
+
+            std::vector<unsigned char> opened;
+            double start = now_seconds();
+            Opening_Sequential(gray, opened, width, height, kernel_size);
+            busy += now_seconds() - start;
+            ++images;
+
+            if (!output_paths.empty()) {
+                stbi_write_png(output_paths[i].c_str(), width, height, 1, opened.data(), width);
+            }
+        }
+        queue->done.fetch_add(1);
+    }
+
+    queue->busy_time[worker] = busy;
+    queue->images[worker] = images;
+}
+
+} // namespace
+
+bool Opening_Sharded(const std::vector<std::string>& input_paths,
+                     const std::vector<std::string>& output_paths,
+                     const int kernel_size, const int num_processes,
+                     ShardedResult& result, const bool progress) {
+
+    const int processes = std::max(1, std::min(num_processes, MAX_SHARD_PROCESSES));
+    const int num_inputs = static_cast<int>(input_paths.size());
+    if (!output_paths.empty() && output_paths.size() != input_paths.size()) return false;
+
+    // the name is only needed until the mapping exists (children inherit it)
+    const std::string name = "/morph_shard_" + std::to_string(getpid());
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return false;
+    shm_unlink(name.c_str());
+    if (ftruncate(fd, sizeof(ShardQueue)) != 0) {
+        close(fd);
+        return false;
+    }
+    void* memory = mmap(nullptr, sizeof(ShardQueue), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) return false;
+
+    ShardQueue* queue = new (memory) ShardQueue();
+    queue->next.store(0);
+    queue->done.store(0);
+    queue->failed.store(0);
+
+    // flush before forking so buffered output is not written twice
+    std::cout.flush();
+
+    double start = now_seconds();
+    std::vector<pid_t> children;
+    for (int p = 0; p < processes; ++p) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            shard_worker(queue, p, input_paths, output_paths, kernel_size);
+            _exit(0);
+        }
+        if (pid < 0) {
+            queue->failed.fetch_add(1);
+            break;
+        }
+        children.push_back(pid);
+    }
+
+    // wait for the workers, reporting progress meanwhile
+    int last_done = -1;
+    size_t running = children.size();
+    while (running > 0) {
+        int status;
+        pid_t pid = waitpid(-1, &status, progress ? WNOHANG : 0);
+        if (pid > 0) {
+            --running;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) queue->failed.fetch_add(1);
+        } else if (pid < 0) {
+            break;
+        } else {
+            usleep(20000);
+        }
+
+        const int done = queue->done.load();
+        if (progress && done != last_done) {
+            std::cout << "\r  Progress: " << done << "/" << num_inputs << std::flush;
+            last_done = done;
+        }
+    }
+    if (progress) std::cout << std::endl;
+
+    result.wall_time = now_seconds() - start;
+    result.processes = static_cast<int>(children.size());
+    result.busy_time.assign(queue->busy_time, queue->busy_time + result.processes);
+    result.images_per_process.assign(queue->images, queue->images + result.processes);
+    result.images = 0;
+    for (int images : result.images_per_process) result.images += images;
+
+    const bool ok = queue->failed.load() == 0 && running == 0;
+    queue->~ShardQueue();
+    munmap(memory, sizeof(ShardQueue));
+    return ok;
+}
+
+#else
+
+bool Opening_Sharded(const std::vector<std::string>&, const std::vector<std::string>&,
+                     const int, const int, ShardedResult& result, const bool) {
+    result = ShardedResult();
+    return false;
+}
+
+#endif
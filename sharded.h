@@ -0,0 +1,40 @@
+#ifndef SHARDED_H
+#define SHARDED_H
+
+#include <string>
+#include <vector>
+
+// --- PROCESAMIENTO POR LOTES EN VARIOS PROCESOS (memoria compartida) ---
+//
+// The launcher forks num_processes workers. They pull image indices from a
+// lock-free queue (one atomic counter) in a POSIX shared memory segment
+// (shm_open + mmap) and filter each image with Opening_Sequential, so every
+// process has its own allocator and no OpenMP runtime is shared or forked.
+// Per-process busy time and image counts are written back to the segment.
+// POSIX only; elsewhere Opening_Sharded returns false.
+
+struct ShardedResult {
+    int processes = 0;
+    int images = 0;
+    double wall_time = 0.0;               // fork to last exit, I/O included
+    std::vector<double> busy_time;        // seconds in Opening_Sequential, per process
+    std::vector<int> images_per_process;
+
+    // Filtering critical path: the busiest process
+    double max_busy_time() const {
+        double max_time = 0.0;
+        for (double t : busy_time) max_time = t > max_time ? t : max_time;
+        return max_time;
+    }
+};
+
+// Filters input_paths[i] into output_paths[i] (PNG; no output if
+// output_paths is empty). Prints progress when `progress` is set.
+// Returns false if the segment or the processes cannot be created or a
+// worker fails.
+bool Opening_Sharded(const std::vector<std::string>& input_paths,
+                     const std::vector<std::string>& output_paths,
+                     const int kernel_size, const int num_processes,
+                     ShardedResult& result, const bool progress = false);
+
+#endif // SHARDED_H
@@ -0,0 +1,146 @@
+#include "streaming.h"
+#include "morph_1d.h"
+#include <algorithm>
+#include <omp.h>
+
+// Below this width the per-row fork/join costs more than the vertical pass
+static const int STREAM_PARALLEL_MIN_WIDTH = 4096;
+
+StreamingStage::StreamingStage(StreamOp op, int width, int height, int kernel_size, RowSink sink)
+    : op_(op), width_(width), height_(height), radius_(kernel_size / 2),
+      ring_rows_(2 * (kernel_size / 2) + 1), sink_(std::move(sink)) {
+
+    ring_.resize(static_cast<size_t>(ring_rows_) * width_);
+    out_row_.resize(width_);
+    window_.resize(ring_rows_);
+}
+
+void StreamingStage::push_row(const unsigned char* row) {
+    // horizontal pass straight into the ring slot of this row
+    static thread_local VanHerkScratch scratch;
+    unsigned char* slot = &ring_[static_cast<size_t>(rows_in_ % ring_rows_) * width_];
+    if (op_ == StreamOp::Erode) {
+        erode_1d(row, 1, slot, 1, width_, radius_, scratch);
+    } else {
+        dilate_1d(row, 1, slot, 1, width_, radius_, scratch);
+    }
+
+    const int y_in = rows_in_++;
+
+    // row y is final once row y + radius has arrived
+    if (y_in >= radius_) {
+        emit_row(y_in - radius_);
+    }
+    if (y_in == height_ - 1) {
+        for (int y = std::max(0, height_ - radius_); y < height_; ++y) {
+            emit_row(y);
+        }
+    }
+}
+
+// out[j] = op(out[j], row[j]) over a column range; one row at a time keeps
+// both pointers sequential so the loop vectorizes
+template <typename Op>
+static void merge_row(unsigned char* out, const unsigned char* row, const int begin, const int end) {
+    const Op op;
+    #pragma omp simd
+    for (int j = begin; j < end; ++j) {
+        out[j] = op(out[j], row[j]);
+    }
+}
+
+template <typename Op>
+static void merge_window(unsigned char* out, const unsigned char* const* window, const int count,
+                         const int begin, const int end) {
+    std::copy(window[0] + begin, window[0] + end, out + begin);
+    for (int r = 1; r < count; ++r) {
+        merge_row<Op>(out, window[r], begin, end);
+    }
+}
+
+void StreamingStage::emit_row(int y) {
+    const int first = std::max(0, y - radius_);
+    const int last = std::min(height_ - 1, y + radius_);
+    const int count = last - first + 1;
+    unsigned char* out = out_row_.data();
+
+    // ring slots of the vertical window, resolved once per output row
+    for (int r = first; r <= last; ++r) {
+        window_[r - first] = &ring_[static_cast<size_t>(r % ring_rows_) * width_];
+    }
+    const unsigned char* const* window = window_.data();
+
+    // each thread sweeps the window over its own contiguous column range
+    #pragma omp parallel if(width_ >= STREAM_PARALLEL_MIN_WIDTH)
+    {
+        const int threads = omp_get_num_threads();
+        const int thread = omp_get_thread_num();
+        const int begin = static_cast<int>(static_cast<long long>(width_) * thread / threads);
+        const int end = static_cast<int>(static_cast<long long>(width_) * (thread + 1) / threads);
+
+        if (op_ == StreamOp::Erode) {
+            merge_window<MinOp>(out, window, count, begin, end);
+        } else {
+            merge_window<MaxOp>(out, window, count, begin, end);
+        }
+    }
+
+    sink_(y, out);
+}
+
+StreamingOpening::StreamingOpening(int width, int height, int kernel_size, RowSink sink)
+    : dilate_(StreamOp::Dilate, width, height, kernel_size, std::move(sink)),
+      erode_(StreamOp::Erode, width, height, kernel_size,
+             [this](int, const unsigned char* row) { dilate_.push_row(row); }) {
+}
+
+void StreamingOpening::push_row(const unsigned char* row) {
+    erode_.push_row(row);
+}
+
+// Pulls every row from `source` through `stage`
+template <typename Stage>
+static void run_stream(Stage& stage, const RowSource& source, const int width, const int height) {
+    std::vector<unsigned char> row(width);
+    for (int y = 0; y < height; ++y) {
+        source(y, row.data());
+        stage.push_row(row.data());
+    }
+}
+
+void Erode_Streaming(const RowSource& source, const RowSink& sink,
+                     const int width, const int height, const int kernel_size) {
+
+    StreamingStage stage(StreamOp::Erode, width, height, kernel_size, sink);
+    run_stream(stage, source, width, height);
+}
+
+void Dilate_Streaming(const RowSource& source, const RowSink& sink,
+                      const int width, const int height, const int kernel_size) {
+
+    StreamingStage stage(StreamOp::Dilate, width, height, kernel_size, sink);
+    run_stream(stage, source, width, height);
+}
+
+void Opening_Streaming(const RowSource& source, const RowSink& sink,
+                       const int width, const int height, const int kernel_size) {
+
+    StreamingOpening pipeline(width, height, kernel_size, sink);
+    run_stream(pipeline, source, width, height);
+}
+
+void Opening_Streaming(const std::vector<unsigned char>& input,
+                       std::vector<unsigned char>& output,
+                       const int width, const int height, const int kernel_size) {
+
+    output.resize(width * height);
+
+    Opening_Streaming(
+        [&](int y, unsigned char* row) {
+            std::copy(input.begin() + y * width, input.begin() + (y + 1) * width, row);
+        },
+        [&](int y, const unsigned char* row) {
+            std::copy(row, row + width, output.begin() + y * width);
+        },
+        width, height, kernel_size);
+}
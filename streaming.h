@@ -0,0 +1,70 @@
+#ifndef STREAMING_H
+#define STREAMING_H
+
+#include <functional>
+#include <vector>
+
+// --- OPERACIONES MORFOLÓGICAS EN STREAMING (por filas) ---
+//
+// Rows are pushed top to bottom and each stage keeps only a ring of
+// kernel_size rows, so working memory is O(kernel_size * width) instead of
+// whole images. Results are identical to the *_Sequential versions.
+
+// Fills `row` (width pixels) with input row `y`
+using RowSource = std::function<void(int y, unsigned char* row)>;
+// Receives output row `y` as soon as it is final
+using RowSink = std::function<void(int y, const unsigned char* row)>;
+
+enum class StreamOp { Erode, Dilate };
+
+class StreamingStage {
+public:
+    StreamingStage(StreamOp op, int width, int height, int kernel_size, RowSink sink);
+
+    // Rows must be pushed in order 0 .. height-1
+    void push_row(const unsigned char* row);
+
+private:
+    void emit_row(int y);
+
+    StreamOp op_;
+    int width_;
+    int height_;
+    int radius_;
+    int ring_rows_;
+    int rows_in_ = 0;
+    RowSink sink_;
+    std::vector<unsigned char> ring_;   // horizontally filtered rows
+    std::vector<unsigned char> out_row_;
+    std::vector<const unsigned char*> window_;   // ring rows of the row being emitted
+};
+
+// Erosion -> dilation pipeline: two rings, one input row in flight
+class StreamingOpening {
+public:
+    StreamingOpening(int width, int height, int kernel_size, RowSink sink);
+    StreamingOpening(const StreamingOpening&) = delete;
+    StreamingOpening& operator=(const StreamingOpening&) = delete;
+
+    void push_row(const unsigned char* row);
+
+private:
+    StreamingStage dilate_;
+    StreamingStage erode_;
+};
+
+void Erode_Streaming(const RowSource& source, const RowSink& sink,
+                     const int width, const int height, const int kernel_size);
+
+void Dilate_Streaming(const RowSource& source, const RowSink& sink,
+                      const int width, const int height, const int kernel_size);
+
+void Opening_Streaming(const RowSource& source, const RowSink& sink,
+                       const int width, const int height, const int kernel_size);
+
+// Convenience overload for in-memory images
+void Opening_Streaming(const std::vector<unsigned char>& input,
+                       std::vector<unsigned char>& output,
+                       const int width, const int height, const int kernel_size);
+
+#endif // STREAMING_H
@@ -0,0 +1,101 @@
+#include "temporal.h"
+#include "roi.h"
+#include <algorithm>
+#include <cstring>
+#include <omp.h>
+
+TemporalExtremum::TemporalExtremum(int num_pixels, int window, bool use_min)
+    : num_pixels_(num_pixels), window_(std::max(1, window)), use_min_(use_min) {
+
+    ring_.resize(static_cast<size_t>(window_) * num_pixels_);
+    suffix_.assign(static_cast<size_t>(window_) * num_pixels_, use_min_ ? 255 : 0);
+    prefix_.resize(num_pixels_);
+}
+
+void TemporalExtremum::push(const unsigned char* frame, unsigned char* result) {
+    const int n = num_pixels_;
+    const int m = frames_seen_ % window_;
+    const bool use_min = use_min_;
+    unsigned char* slot = &ring_[static_cast<size_t>(m) * n];
+    unsigned char* prefix = prefix_.data();
+    // window [t - window + 1, t] = tail of the previous block + head of this one
+    const unsigned char* tail = (m == window_ - 1) ? nullptr : &suffix_[static_cast<size_t>(m + 1) * n];
+
+    #pragma omp parallel for simd schedule(static)
+    for (int i = 0; i < n; ++i) {
+        const unsigned char v = frame[i];
+        slot[i] = v;
+        unsigned char p = (m == 0) ? v : (use_min ? std::min(prefix[i], v) : std::max(prefix[i], v));
+        prefix[i] = p;
+        if (tail) p = use_min ? std::min(p, tail[i]) : std::max(p, tail[i]);
+        result[i] = p;
+    }
+
+    frames_seen_++;
+
+    // block complete: rebuild suffix extrema from the ring
+    if (m == window_ - 1 && window_ > 1) {
+        std::memcpy(&suffix_[static_cast<size_t>(window_ - 1) * n],
+                    &ring_[static_cast<size_t>(window_ - 1) * n], n);
+
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; ++i) {
+            unsigned char acc = suffix_[static_cast<size_t>(window_ - 1) * n + i];
+            for (int k = window_ - 2; k >= 1; --k) {
+                const unsigned char v = ring_[static_cast<size_t>(k) * n + i];
+                acc = use_min ? std::min(acc, v) : std::max(acc, v);
+                suffix_[static_cast<size_t>(k) * n + i] = acc;
+            }
+        }
+    }
+}
+
+const unsigned char* TemporalExtremum::recent(int age) const {
+    const int t = frames_seen_ - 1 - age;
+    return &ring_[static_cast<size_t>(t % window_) * num_pixels_];
+}
+
+SpatioTemporalOpening::SpatioTemporalOpening(int width, int height, int kernel_size, int temporal_window)
+    : width_(width), height_(height), kernel_size_(kernel_size),
+      window_(std::max(1, temporal_window)),
+      erode_(width * height, window_, true),
+      dilate_(width * height, window_, false),
+      spatial_(width * height), eroded_(width * height) {
+}
+
+bool SpatioTemporalOpening::push_frame(const std::vector<unsigned char>& frame,
+                                       std::vector<unsigned char>& output) {
+    const Rect full = {0, 0, width_, height_};
+
+    Erode_ROI_Parallel(frame, spatial_, width_, height_, kernel_size_, full);
+    erode_.push(spatial_.data(), eroded_.data());
+
+    Dilate_ROI_Parallel(eroded_, spatial_, width_, height_, kernel_size_, full);
+    output.resize(width_ * height_);
+    dilate_.push(spatial_.data(), output.data());
+
+    return dilate_.frames_seen() >= window_;
+}
+
+// Pending frames s have windows [s, last] clipped at the end of the sequence
+bool SpatioTemporalOpening::flush(std::vector<unsigned char>& output) {
+    const int seen = dilate_.frames_seen();
+    const int pending = std::min(seen, window_ - 1);
+    if (flushed_ >= pending) return false;
+
+    // oldest pending frame first; it needs every frame after it
+    const int span = pending - flushed_;
+    const int n = width_ * height_;
+    output.assign(n, 0);
+    for (int age = 0; age < span; ++age) {
+        const unsigned char* frame = dilate_.recent(age);
+
+        #pragma omp parallel for simd schedule(static)
+        for (int i = 0; i < n; ++i) {
+            output[i] = std::max(output[i], frame[i]);
+        }
+    }
+
+    flushed_++;
+    return true;
+}
@@ -0,0 +1,60 @@
+#ifndef TEMPORAL_H
+#define TEMPORAL_H
+
+#include <vector>
+
+// --- MORFOLOGÍA ESPACIO-TEMPORAL SOBRE SECUENCIAS DE FOTOGRAMAS ---
+
+// Per-pixel min or max over the last `window` frames (fewer at the start of
+// the sequence). The ring buffer holds the last `window` frames; van Herk
+// blocks across time keep the work at O(1) comparisons per pixel and frame
+// (amortized: suffix extrema are rebuilt once every `window` frames).
+class TemporalExtremum {
+public:
+    TemporalExtremum(int num_pixels, int window, bool use_min);
+
+    // Adds the next frame and writes the extremum over the window ending at it
+    void push(const unsigned char* frame, unsigned char* result);
+
+    // Frame pushed `age` frames ago (0 = newest); age < min(frames_seen(), window)
+    const unsigned char* recent(int age) const;
+
+    int frames_seen() const { return frames_seen_; }
+
+private:
+    int num_pixels_;
+    int window_;
+    bool use_min_;
+    int frames_seen_ = 0;
+    std::vector<unsigned char> ring_;    // window x num_pixels, slot = t % window
+    std::vector<unsigned char> suffix_;  // extrema from slot k to the end of the previous block
+    std::vector<unsigned char> prefix_;  // extremum since the start of the current block
+};
+
+// Opening by a kernel_size x kernel_size x temporal_window box: spatial
+// erosion + causal temporal min, then spatial dilation + temporal max over
+// the following frames (the adjoint), so output lags input by
+// temporal_window - 1 frames.
+class SpatioTemporalOpening {
+public:
+    SpatioTemporalOpening(int width, int height, int kernel_size, int temporal_window);
+
+    // Returns true and fills `output` with opened frame t - (temporal_window - 1)
+    bool push_frame(const std::vector<unsigned char>& frame, std::vector<unsigned char>& output);
+
+    // After the last frame: returns the delayed frames one per call, false when drained
+    bool flush(std::vector<unsigned char>& output);
+
+private:
+    int width_;
+    int height_;
+    int kernel_size_;
+    int window_;
+    int flushed_ = 0;
+    TemporalExtremum erode_;
+    TemporalExtremum dilate_;
+    std::vector<unsigned char> spatial_;
+    std::vector<unsigned char> eroded_;
+};
+
+#endif // TEMPORAL_H
@@ -0,0 +1,190 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+// Fixed-capacity Chase-Lev deque (Le et al. memory orderings). Items are
+// ranges packed as begin << 32 | end so slots can be plain atomics.
+class WorkStealingDeque {
+public:
+    // Lazy splitting keeps at most log2(n / grain) + 1 ranges per deque
+    static const long long CAPACITY = 1024;
+
+    // Owner only
+    bool push(uint64_t item) {
+        const long long b = bottom_.load(std::memory_order_relaxed);
+        const long long t = top_.load(std::memory_order_acquire);
+        if (b - t >= CAPACITY) return false;
+        buffer_[b & (CAPACITY - 1)].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only, takes the most recently pushed item
+    bool pop(uint64_t& item) {
+        const long long b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        long long t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        item = buffer_[b & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (t == b) {
+            // last item: race against thieves for it
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread, takes the oldest item
+    bool steal(uint64_t& item) {
+        long long t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const long long b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return false;
+        item = buffer_[t & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        return top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    }
+
+private:
+    alignas(64) std::atomic<long long> top_{0};
+    alignas(64) std::atomic<long long> bottom_{0};
+    std::atomic<uint64_t> buffer_[CAPACITY];
+};
+
+static uint64_t pack_range(const int begin, const int end) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(begin)) << 32) | static_cast<uint32_t>(end);
+}
+
+static void unpack_range(const uint64_t range, int& begin, int& end) {
+    begin = static_cast<int>(range >> 32);
+    end = static_cast<int>(range & 0xffffffffu);
+}
+
+ThreadPool::ThreadPool(int num_threads)
+    : num_threads_(std::max(1, num_threads)) {
+
+    for (int t = 0; t < num_threads_; ++t) {
+        deques_.push_back(std::unique_ptr<WorkStealingDeque>(new WorkStealingDeque()));
+    }
+    for (int t = 1; t < num_threads_; ++t) {
+        workers_.emplace_back(&ThreadPool::worker_loop, this, t);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_) worker.join();
+}
+
+void ThreadPool::worker_loop(const int id) {
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        run_job(id);
+        active_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+// Own deque first, then one sweep over the others starting at a neighbour
+bool ThreadPool::take_range(const int id, uint64_t& range) {
+    if (deques_[id]->pop(range)) return true;
+    for (int k = 1; k < num_threads_; ++k) {
+        if (deques_[(id + k) % num_threads_]->steal(range)) return true;
+    }
+    return false;
+}
+
+void ThreadPool::run_job(const int id) {
+    WorkStealingDeque& own = *deques_[id];
+    uint64_t range;
+
+    while (remaining_.load(std::memory_order_acquire) > 0) {
+        if (!take_range(id, range)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        int begin, end;
+        unpack_range(range, begin, end);
+
+        // keep the lower half, publish the upper half for thieves
+        while (end - begin > grain_) {
+            const int mid = begin + (end - begin) / 2;
+            if (!own.push(pack_range(mid, end))) break;
+            end = mid;
+        }
+
+        (*body_)(begin, end);
+        remaining_.fetch_sub(end - begin, std::memory_order_acq_rel);
+    }
+}
+
+void ThreadPool::parallel_for(const int n, const int grain, const RangeBody& body) {
+    if (n <= 0) return;
+    if (num_threads_ == 1 || n <= grain) {
+        body(0, n);
+        return;
+    }
+
+    body_ = &body;
+    grain_ = std::max(1, grain);
+    remaining_.store(n, std::memory_order_relaxed);
+    active_.store(num_threads_ - 1, std::memory_order_relaxed);
+
+    // one contiguous share per thread; workers are asleep, so pushing into
+    // their deques from here is safe (the mutex publishes it)
+    for (int t = 0; t < num_threads_; ++t) {
+        const int begin = static_cast<int>(static_cast<long long>(n) * t / num_threads_);
+        const int end = static_cast<int>(static_cast<long long>(n) * (t + 1) / num_threads_);
+        if (begin < end) deques_[t]->push(pack_range(begin, end));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    run_job(0);
+
+    // workers must be out of the job before body_ and the deques are reused
+    while (active_.load(std::memory_order_acquire) > 0) std::this_thread::yield();
+    body_ = nullptr;
+}
+
+static std::unique_ptr<ThreadPool>& default_pool() {
+    static std::unique_ptr<ThreadPool> pool;
+    return pool;
+}
+
+ThreadPool& Default_Thread_Pool() {
+    std::unique_ptr<ThreadPool>& pool = default_pool();
+    if (!pool) {
+        const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+        pool.reset(new ThreadPool(hardware > 0 ? hardware : 1));
+    }
+    return *pool;
+}
+
+void Set_Thread_Pool_Size(const int num_threads) {
+    std::unique_ptr<ThreadPool>& pool = default_pool();
+    if (pool && pool->num_threads() == num_threads) return;
+    pool.reset();
+    pool.reset(new ThreadPool(num_threads));
+}
@@ -0,0 +1,66 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// --- POOL DE HILOS PERSISTENTE (work stealing, sin OpenMP) ---
+//
+// Workers are created once and sleep between jobs, so a call costs one
+// wake-up instead of a fork/join. Each worker owns a Chase-Lev deque of
+// index ranges: the owner splits its range in halves and works on the
+// bottom, idle workers steal the biggest ranges from the top of others.
+
+// Range [begin, end) of the current job, passed to the loop body
+using RangeBody = std::function<void(int begin, int end)>;
+
+class WorkStealingDeque;
+
+class ThreadPool {
+public:
+    // The calling thread takes part in every job, so num_threads - 1 workers
+    // are spawned
+    explicit ThreadPool(int num_threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int num_threads() const { return num_threads_; }
+
+    // Runs body over [0, n) in ranges of at most `grain` indices and returns
+    // when all of them are done. Not reentrant: call from one thread at a time.
+    void parallel_for(int n, int grain, const RangeBody& body);
+
+private:
+    void worker_loop(int id);
+    void run_job(int id);
+    bool take_range(int id, uint64_t& range);
+
+    int num_threads_;
+    std::vector<std::unique_ptr<WorkStealingDeque>> deques_;
+    std::vector<std::thread> workers_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+
+    const RangeBody* body_ = nullptr;
+    int grain_ = 1;
+    std::atomic<long long> remaining_{0};  // indices not yet processed
+    std::atomic<int> active_{0};           // workers still inside the job
+};
+
+// Process-wide pool used by the *_Pool functions (hardware threads by default)
+ThreadPool& Default_Thread_Pool();
+
+// Recreates the default pool with num_threads threads (not while it is running)
+void Set_Thread_Pool_Size(int num_threads);
+
+#endif // THREAD_POOL_H
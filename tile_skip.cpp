@@ -0,0 +1,157 @@
+#include "tile_skip.h"
+#include <algorithm>
+#include <cstring>
+#include <omp.h>
+
+static const int SKIP_TILE_SIZE = 64;
+
+// Min and max of every tile (vectorized row reductions)
+static void tile_min_max(const std::vector<unsigned char>& input,
+                         const int width, const int height,
+                         const int tiles_x, const int tiles_y,
+                         std::vector<unsigned char>& tile_min,
+                         std::vector<unsigned char>& tile_max) {
+
+    tile_min.resize(tiles_x * tiles_y);
+    tile_max.resize(tiles_x * tiles_y);
+
+    #pragma omp parallel for collapse(2) schedule(static)
+    for (int ty = 0; ty < tiles_y; ++ty) {
+        for (int tx = 0; tx < tiles_x; ++tx) {
+            const int x0 = tx * SKIP_TILE_SIZE;
+            const int x1 = std::min(width, x0 + SKIP_TILE_SIZE);
+            const int y0 = ty * SKIP_TILE_SIZE;
+            const int y1 = std::min(height, y0 + SKIP_TILE_SIZE);
+            unsigned char mn = 255, mx = 0;
+
+            for (int i = y0; i < y1; ++i) {
+                const unsigned char* row = &input[static_cast<size_t>(i) * width];
+                #pragma omp simd reduction(min:mn) reduction(max:mx)
+                for (int j = x0; j < x1; ++j) {
+                    mn = std::min(mn, row[j]);
+                    mx = std::max(mx, row[j]);
+                }
+            }
+            tile_min[ty * tiles_x + tx] = mn;
+            tile_max[ty * tiles_x + tx] = mx;
+        }
+    }
+}
+
+template <bool ERODE>
+static void window_tile(const std::vector<unsigned char>& input,
+                        std::vector<unsigned char>& output,
+                        const int width, const int height, const int kernel_radius,
+                        const int x0, const int y0, const int x1, const int y1) {
+
+    for (int i = y0; i < y1; ++i) {
+        for (int j = x0; j < x1; ++j) {
+            unsigned char val = ERODE ? 255 : 0;
+
+            for (int u = -kernel_radius; u <= kernel_radius; ++u) {
+                for (int v = -kernel_radius; v <= kernel_radius; ++v) {
+                    int ni = i + u;
+                    int nj = j + v;
+
+                    if (ni >= 0 && ni < height && nj >= 0 && nj < width) {
+                        unsigned char current_pixel = input[ni * width + nj];
+                        if (ERODE ? current_pixel < val : current_pixel > val) {
+                            val = current_pixel;
+                        }
+                    }
+                }
+            }
+            output[i * width + j] = val;
+        }
+    }
+}
+
+template <bool ERODE>
+static void tile_skip_filter(const std::vector<unsigned char>& input,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height, const int kernel_size,
+                             TileSkipStats* stats) {
+
+    const int kernel_radius = kernel_size / 2;
+    output.resize(width * height);
+
+    const int tiles_x = (width + SKIP_TILE_SIZE - 1) / SKIP_TILE_SIZE;
+    const int tiles_y = (height + SKIP_TILE_SIZE - 1) / SKIP_TILE_SIZE;
+    std::vector<unsigned char> tile_min, tile_max;
+    tile_min_max(input, width, height, tiles_x, tiles_y, tile_min, tile_max);
+
+    long long tiles_skipped = 0;
+    long long pixels_skipped = 0;
+
+    #pragma omp parallel for collapse(2) schedule(dynamic) reduction(+:tiles_skipped, pixels_skipped)
+    for (int ty = 0; ty < tiles_y; ++ty) {
+        for (int tx = 0; tx < tiles_x; ++tx) {
+            const int x0 = tx * SKIP_TILE_SIZE;
+            const int x1 = std::min(width, x0 + SKIP_TILE_SIZE);
+            const int y0 = ty * SKIP_TILE_SIZE;
+            const int y1 = std::min(height, y0 + SKIP_TILE_SIZE);
+
+            // tiles touched by the halo-extended tile
+            const int hx0 = std::max(0, x0 - kernel_radius) / SKIP_TILE_SIZE;
+            const int hx1 = (std::min(width, x1 + kernel_radius) - 1) / SKIP_TILE_SIZE;
+            const int hy0 = std::max(0, y0 - kernel_radius) / SKIP_TILE_SIZE;
+            const int hy1 = (std::min(height, y1 + kernel_radius) - 1) / SKIP_TILE_SIZE;
+
+            const unsigned char value = tile_min[ty * tiles_x + tx];
+            bool uniform = true;
+            for (int hy = hy0; hy <= hy1 && uniform; ++hy) {
+                for (int hx = hx0; hx <= hx1; ++hx) {
+                    const int t = hy * tiles_x + hx;
+                    if (tile_min[t] != value || tile_max[t] != value) {
+                        uniform = false;
+                        break;
+                    }
+                }
+            }
+
+            if (uniform) {
+                for (int i = y0; i < y1; ++i) {
+                    std::memset(&output[static_cast<size_t>(i) * width + x0], value, x1 - x0);
+                }
+                tiles_skipped++;
+                pixels_skipped += static_cast<long long>(x1 - x0) * (y1 - y0);
+            } else {
+                window_tile<ERODE>(input, output, width, height, kernel_radius, x0, y0, x1, y1);
+            }
+        }
+    }
+
+    if (stats) {
+        stats->tiles_total += static_cast<long long>(tiles_x) * tiles_y;
+        stats->tiles_skipped += tiles_skipped;
+        stats->pixels_total += static_cast<long long>(width) * height;
+        stats->pixels_skipped += pixels_skipped;
+    }
+}
+
+void Dilate_Parallel_TileSkip(const std::vector<unsigned char>& input,
+                              std::vector<unsigned char>& output,
+                              const int width, const int height, const int kernel_size,
+                              TileSkipStats* stats) {
+
+    tile_skip_filter<false>(input, output, width, height, kernel_size, stats);
+}
+
+void Erode_Parallel_TileSkip(const std::vector<unsigned char>& input,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height, const int kernel_size,
+                             TileSkipStats* stats) {
+
+    tile_skip_filter<true>(input, output, width, height, kernel_size, stats);
+}
+
+void Opening_Parallel_TileSkip(const std::vector<unsigned char>& input,
+                               std::vector<unsigned char>& output,
+                               const int width, const int height, const int kernel_size,
+                               TileSkipStats* stats) {
+
+    std::vector<unsigned char> temp;
+
+    Erode_Parallel_TileSkip(input, temp, width, height, kernel_size, stats);
+    Dilate_Parallel_TileSkip(temp, output, width, height, kernel_size, stats);
+}
@@ -0,0 +1,40 @@
+#ifndef TILE_SKIP_H
+#define TILE_SKIP_H
+
+#include <vector>
+
+// --- SALTO DE TESELAS UNIFORMES ---
+//
+// A pre-pass stores min and max per tile. An output tile whose halo-extended
+// neighbourhood only touches constant tiles of the same value is filled
+// with that value; the rest run the usual window kernel. Results are
+// identical to Erode_Parallel / Dilate_Parallel / Opening_Parallel.
+
+struct TileSkipStats {
+    long long tiles_total = 0;
+    long long tiles_skipped = 0;
+    long long pixels_total = 0;
+    long long pixels_skipped = 0;
+
+    double skipped_fraction() const {
+        return pixels_total > 0 ? static_cast<double>(pixels_skipped) / pixels_total : 0.0;
+    }
+};
+
+// `stats` is optional; counts are added to it (Opening reports both stages)
+void Dilate_Parallel_TileSkip(const std::vector<unsigned char>& input,
+                              std::vector<unsigned char>& output,
+                              const int width, const int height, const int kernel_size,
+                              TileSkipStats* stats = nullptr);
+
+void Erode_Parallel_TileSkip(const std::vector<unsigned char>& input,
+                             std::vector<unsigned char>& output,
+                             const int width, const int height, const int kernel_size,
+                             TileSkipStats* stats = nullptr);
+
+void Opening_Parallel_TileSkip(const std::vector<unsigned char>& input,
+                               std::vector<unsigned char>& output,
+                               const int width, const int height, const int kernel_size,
+                               TileSkipStats* stats = nullptr);
+
+#endif // TILE_SKIP_H
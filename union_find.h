@@ -0,0 +1,29 @@
+#ifndef UNION_FIND_H
+#define UNION_FIND_H
+
+// Union-find over an index array. Roots are always the smallest index of
+// their set, so after merging, a root is the first pixel of its component
+// in raster order.
+
+inline int uf_find(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];  // path halving
+        x = parent[x];
+    }
+    return x;
+}
+
+// Root lookup without path compression, safe while other threads read
+inline int uf_root(const int* parent, int x) {
+    while (parent[x] != x) x = parent[x];
+    return x;
+}
+
+inline void uf_union(int* parent, int a, int b) {
+    a = uf_find(parent, a);
+    b = uf_find(parent, b);
+    if (a < b) parent[b] = a;
+    else if (b < a) parent[a] = b;
+}
+
+#endif // UNION_FIND_H
@@ -0,0 +1,240 @@
+#include "watershed.h"
+#include "parallel.h"
+#include <algorithm>
+#include <omp.h>
+
+namespace {
+
+// One FIFO per grey level; a push below the current level moves it back
+class HierarchicalQueue {
+public:
+    void push(const int level, const int index) {
+        buckets_[level].push_back(index);
+        current_ = std::min(current_, level);
+        size_++;
+    }
+
+    bool empty() const { return size_ == 0; }
+
+    // Pops the oldest pixel of the lowest non-empty level
+    int pop(int& level) {
+        while (heads_[current_] == buckets_[current_].size()) {
+            buckets_[current_].clear();
+            heads_[current_] = 0;
+            current_++;
+        }
+        level = current_;
+        size_--;
+        return buckets_[current_][heads_[current_]++];
+    }
+
+private:
+    std::vector<int> buckets_[256];
+    size_t heads_[256] = {};
+    int current_ = 255;
+    size_t size_ = 0;
+};
+
+const int DX[4] = {1, -1, 0, 0};
+const int DY[4] = {0, 0, 1, -1};
+
+// Flooding cost of a pixel: (level, dist). level is the lowest flooding
+// level at which a marker reaches the pixel, dist the number of steps since
+// the path entered that level (it restarts at 0 on every climb). Every pixel
+// takes the cheapest cost over all paths from the markers, and the smallest
+// label among the neighbours it is reached from at that cost. Both are fixed
+// points of the neighbourhood and do not depend on the visiting order, so
+// tiles can compute them independently and then correct each other across
+// seams until nothing changes.
+struct Cost {
+    int level;
+    int dist;
+    int label;
+};
+
+bool operator<(const Cost& a, const Cost& b) {
+    if (a.level != b.level) return a.level < b.level;
+    if (a.dist != b.dist) return a.dist < b.dist;
+    return a.label < b.label;
+}
+
+struct Tile {
+    int x0, y0, x1, y1;
+
+    bool contains(const int x, const int y) const { return x >= x0 && x < x1 && y >= y0 && y < y1; }
+};
+
+struct FloodState {
+    const std::vector<unsigned char>& gradient;
+    const std::vector<int>& markers;
+    std::vector<int>& labels;
+    std::vector<unsigned char> level;
+    std::vector<int> dist;
+    int width;
+    int height;
+
+    // Recomputes pixel (x, y) from its labelled neighbours (only those in
+    // `tile` when `within` is set); markers keep their own label. Returns
+    // true when the pixel changed.
+    bool update(const int x, const int y, const Tile& tile, const bool within) {
+        const int n = y * width + x;
+        if (markers[n] != 0) return false;
+
+        bool found = false;
+        Cost best{};
+        for (int d = 0; d < 4; ++d) {
+            const int qx = x + DX[d];
+            const int qy = y + DY[d];
+            if (qx < 0 || qx >= width || qy < 0 || qy >= height) continue;
+            if (within && !tile.contains(qx, qy)) continue;
+
+            const int q = qy * width + qx;
+            if (labels[q] == 0) continue;
+
+            const Cost c = level[q] >= gradient[n] ? Cost{level[q], dist[q] + 1, labels[q]}
+                                                   : Cost{gradient[n], 0, labels[q]};
+            if (!found || c < best) {
+                best = c;
+                found = true;
+            }
+        }
+
+        if (!found) return false;
+        if (labels[n] == best.label && level[n] == best.level && dist[n] == best.dist) return false;
+
+        labels[n] = best.label;
+        level[n] = static_cast<unsigned char>(best.level);
+        dist[n] = best.dist;
+        return true;
+    }
+};
+
+// Propagates the queued pixels inside the tile until no pixel changes.
+// Entries left behind at a higher level than their pixel's are skipped.
+void flood(FloodState& state, HierarchicalQueue& queue, const Tile& tile, const bool within) {
+    const int width = state.width;
+
+    while (!queue.empty()) {
+        int level;
+        const int p = queue.pop(level);
+        if (level != state.level[p]) continue;
+
+        const int px = p % width;
+        const int py = p / width;
+
+        for (int d = 0; d < 4; ++d) {
+            const int nx = px + DX[d];
+            const int ny = py + DY[d];
+            if (!tile.contains(nx, ny)) continue;
+
+            if (state.update(nx, ny, tile, within)) queue.push(state.level[ny * width + nx], ny * width + nx);
+        }
+    }
+}
+
+// Recomputes the border pixels of the tile from all their neighbours and
+// floods the changes into the tile. Neighbouring tiles must not be running.
+bool merge_seams(FloodState& state, const Tile& tile) {
+    HierarchicalQueue queue;
+    bool changed = false;
+
+    auto visit = [&](const int x, const int y) {
+        if (state.update(x, y, tile, false)) {
+            queue.push(state.level[y * state.width + x], y * state.width + x);
+            changed = true;
+        }
+    };
+
+    for (int x = tile.x0; x < tile.x1; ++x) {
+        visit(x, tile.y0);
+        if (tile.y1 - 1 > tile.y0) visit(x, tile.y1 - 1);
+    }
+    for (int y = tile.y0 + 1; y < tile.y1 - 1; ++y) {
+        visit(tile.x0, y);
+        if (tile.x1 - 1 > tile.x0) visit(tile.x1 - 1, y);
+    }
+
+    flood(state, queue, tile, false);
+    return changed;
+}
+
+} // namespace
+
+void Watershed_Parallel(const std::vector<unsigned char>& gradient,
+                        const std::vector<int>& markers,
+                        std::vector<int>& labels,
+                        const int width, const int height,
+                        const int tile_size) {
+
+    labels.assign(markers.begin(), markers.begin() + width * height);
+
+    FloodState state{gradient, markers, labels,
+                     std::vector<unsigned char>(gradient.begin(), gradient.begin() + width * height),
+                     std::vector<int>(width * height, 0), width, height};
+
+    const int side = tile_size > 0 ? tile_size : std::max(width, height);
+    const int tiles_x = (width + side - 1) / side;
+    const int tiles_y = (height + side - 1) / side;
+
+    // tiles in checkerboard colours: tiles sharing a side never have the same colour
+    std::vector<Tile> tiles[2];
+    for (int ty = 0; ty < tiles_y; ++ty) {
+        for (int tx = 0; tx < tiles_x; ++tx) {
+            const Tile tile{tx * side, ty * side, std::min(width, (tx + 1) * side), std::min(height, (ty + 1) * side)};
+            tiles[(tx + ty) % 2].push_back(tile);
+        }
+    }
+
+    // phase 1: every tile floods from its own markers, as if it were the image
+    for (const std::vector<Tile>& colour : tiles) {
+        const int num_tiles = static_cast<int>(colour.size());
+
+        #pragma omp parallel for schedule(dynamic)
+        for (int t = 0; t < num_tiles; ++t) {
+            const Tile& tile = colour[t];
+            HierarchicalQueue queue;
+            for (int y = tile.y0; y < tile.y1; ++y) {
+                for (int x = tile.x0; x < tile.x1; ++x) {
+                    const int p = y * width + x;
+                    if (labels[p] != 0) queue.push(gradient[p], p);
+                }
+            }
+            flood(state, queue, tile, true);
+        }
+    }
+
+    // phase 2: seam merge. Tiles of one colour at a time re-evaluate their
+    // border pixels against the (idle) neighbouring tiles, so a basin that
+    // reaches a seam at a lower level takes it over, and re-flood from the
+    // changed pixels. Rounds repeat until no tile changes; costs never go up,
+    // and the stable state is the one global flooding reaches.
+    if (tiles_x * tiles_y == 1) return;
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (const std::vector<Tile>& colour : tiles) {
+            const int num_tiles = static_cast<int>(colour.size());
+
+            #pragma omp parallel for schedule(dynamic) reduction(||:changed)
+            for (int t = 0; t < num_tiles; ++t) {
+                if (merge_seams(state, colour[t])) changed = true;
+            }
+        }
+    }
+}
+
+void Segment_Watershed_Parallel(const std::vector<unsigned char>& input,
+                                const std::vector<int>& markers,
+                                std::vector<int>& labels,
+                                const int width, const int height,
+                                const int opening_kernel_size, const int gradient_kernel_size,
+                                const int tile_size) {
+
+    std::vector<unsigned char> opened;
+    std::vector<unsigned char> gradient;
+
+    Opening_Parallel(input, opened, width, height, opening_kernel_size);
+    Gradient_Parallel(opened, gradient, width, height, gradient_kernel_size);
+    Watershed_Parallel(gradient, markers, labels, width, height, tile_size);
+}
@@ -0,0 +1,35 @@
+#ifndef WATERSHED_H
+#define WATERSHED_H
+
+#include <vector>
+
+// --- SEGMENTACIÓN WATERSHED CON MARCADORES ---
+//
+// markers: 0 = unlabeled, > 0 = marker label. Every pixel connected to a
+// marker gets a label (4-connectivity, Meyer flooding with a 256-bucket
+// hierarchical queue). A pixel goes to the basin that reaches it at the
+// lowest flooding level; inside a plateau, to the one that gets there in the
+// fewest steps; remaining ties go to the smallest label. This makes the
+// result independent of the visiting order.
+//
+// The image is split into tile_size x tile_size tiles flooded in parallel
+// from their own markers; seams are then merged by re-evaluating the border
+// pixels against the neighbouring tiles and re-flooding until no pixel
+// changes. The result is exactly the global flooding; tile_size <= 0 floods
+// the whole image as one tile.
+
+void Watershed_Parallel(const std::vector<unsigned char>& gradient,
+                        const std::vector<int>& markers,
+                        std::vector<int>& labels,
+                        const int width, const int height,
+                        const int tile_size = 256);
+
+// In-process chain: Opening_Parallel -> Gradient_Parallel -> Watershed_Parallel
+void Segment_Watershed_Parallel(const std::vector<unsigned char>& input,
+                                const std::vector<int>& markers,
+                                std::vector<int>& labels,
+                                const int width, const int height,
+                                const int opening_kernel_size, const int gradient_kernel_size,
+                                const int tile_size = 256);
+
+#endif // WATERSHED_H